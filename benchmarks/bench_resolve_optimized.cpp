@@ -0,0 +1,139 @@
+#include "services/PlaylistService.h"
+
+#include <QtTest>
+#include <QFileInfo>
+#include <QMap>
+
+/**
+ * bench_resolve_optimized - PlaylistService::resolveOptimizedFiles over a
+ * synthetic 20k-entry zone listing, against the QFileInfo / QMap version
+ * it replaced (one QFileInfo parse and one stat per raw file).
+ *
+ *   cmake -S . -B build -DNCTV_BUILD_BENCHMARKS=ON
+ *   cmake --build build --target bench_resolve_optimized
+ *   ./build/benchmarks/bench_resolve_optimized
+ */
+class BenchResolveOptimized : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void sameResult();
+    void legacy();
+    void current();
+
+private:
+    static QStringList legacyResolve(const QStringList &rawFiles, const QString &optimizedSuffix);
+
+    static constexpr int kEntries = 20000;
+
+    const QString m_suffix = QStringLiteral("_optimized");
+    QStringList   m_paths;
+    PlaylistService::MediaItems m_items;
+};
+
+// ──────────────────────────────────────────────
+// Fixture
+// ──────────────────────────────────────────────
+// A zone folder as scanDirectory() lists it: videos, every other one with
+// its full-frame encode next to it, and some images. The directory does
+// not exist, so the legacy stat fails fast, as for a raw file without twin.
+void BenchResolveOptimized::initTestCase()
+{
+    const QString dir = QStringLiteral("/nonexistent/nctv-bench/main");
+
+    for (int i = 0; m_paths.size() < kEntries; ++i) {
+        const QString stem = dir + QStringLiteral("/clip%1").arg(i, 5, 10, QLatin1Char('0'));
+        if (i % 10 == 9) {
+            m_paths.append(stem + QStringLiteral(".jpg"));
+            continue;
+        }
+        m_paths.append(stem + QStringLiteral(".mp4"));
+        if (i % 2 == 0 && m_paths.size() < kEntries)
+            m_paths.append(stem + m_suffix + QStringLiteral(".mp4"));
+    }
+
+    m_items.reserve(m_paths.size());
+    for (const QString &path : std::as_const(m_paths)) {
+        nctv::MediaItem item;
+        item.filePath = path;
+        item.type = path.endsWith(QStringLiteral(".jpg")) ? nctv::MediaType::Image
+                                                          : nctv::MediaType::Video;
+        m_items.append(item);
+    }
+}
+
+// ──────────────────────────────────────────────
+// Benchmarks
+// ──────────────────────────────────────────────
+void BenchResolveOptimized::sameResult()
+{
+    QStringList resolved;
+    for (const nctv::MediaItem &item : PlaylistService::resolveOptimizedFiles(m_items, m_suffix))
+        resolved.append(item.filePath);
+    QCOMPARE(resolved, legacyResolve(m_paths, m_suffix));
+}
+
+void BenchResolveOptimized::legacy()
+{
+    QStringList result;
+    QBENCHMARK {
+        result = legacyResolve(m_paths, m_suffix);
+    }
+    QVERIFY(!result.isEmpty());
+}
+
+void BenchResolveOptimized::current()
+{
+    PlaylistService::MediaItems result;
+    QBENCHMARK {
+        result = PlaylistService::resolveOptimizedFiles(m_items, m_suffix);
+    }
+    QVERIFY(!result.isEmpty());
+}
+
+// ──────────────────────────────────────────────
+// Previous implementation (for comparison)
+// ──────────────────────────────────────────────
+QStringList BenchResolveOptimized::legacyResolve(const QStringList &rawFiles, const QString &optimizedSuffix)
+{
+    QMap<QString, QString> bestFiles; // baseName → absolutePath
+
+    for (const QString &filePath : rawFiles) {
+        QFileInfo fi(filePath);
+        QString baseName = fi.completeBaseName();
+        const QString ext = fi.suffix();
+        const QString dir = fi.absolutePath();
+
+        // Check if this IS an optimized file
+        const bool isOptimized = baseName.endsWith(optimizedSuffix);
+
+        if (isOptimized) {
+            // Remove the suffix to get the original base name
+            const QString originalBase = baseName.left(baseName.length() - optimizedSuffix.length());
+            const QString key = dir + "/" + originalBase;
+            // Optimized always wins
+            bestFiles[key] = filePath;
+        } else {
+            const QString key = dir + "/" + baseName;
+            // Only insert raw if no optimized version already found
+            if (!bestFiles.contains(key)) {
+                // Check if an optimized version exists on disk
+                const QString optimizedPath = dir + "/" + baseName + optimizedSuffix + "." + ext;
+                if (QFileInfo::exists(optimizedPath)) {
+                    bestFiles[key] = optimizedPath;
+                } else {
+                    bestFiles[key] = filePath;
+                }
+            }
+        }
+    }
+
+    QStringList result = bestFiles.values();
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+QTEST_GUILESS_MAIN(BenchResolveOptimized)
+#include "bench_resolve_optimized.moc"
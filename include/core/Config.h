@@ -4,6 +4,8 @@
 #include <QObject>
 #include <QString>
 #include <QVariantMap>
+#include <QHash>
+#include <QStringList>
 
 /**
  * Config - Application configuration manager.
@@ -23,10 +25,29 @@ class Config : public QObject
     Q_PROPERTY(int     imageDurationMs READ imageDurationMs  NOTIFY configChanged)
     Q_PROPERTY(QString playlistRoot    READ playlistRoot     NOTIFY configChanged)
     Q_PROPERTY(QString logPath         READ logPath          NOTIFY configChanged)
+    Q_PROPERTY(QString dataPath        READ dataPath         NOTIFY configChanged)
     Q_PROPERTY(int     targetWidth     READ targetWidth      NOTIFY configChanged)
     Q_PROPERTY(int     targetHeight    READ targetHeight     NOTIFY configChanged)
+    Q_PROPERTY(QString renderMode      READ renderMode       NOTIFY configChanged)
     Q_PROPERTY(bool    audioEnabled    READ audioEnabled     NOTIFY configChanged)
+    Q_PROPERTY(bool    watchPlaylists  READ watchPlaylists   NOTIFY configChanged)
+    Q_PROPERTY(bool    sniffMediaTypes READ sniffMediaTypes  NOTIFY configChanged)
     Q_PROPERTY(QString optimizedSuffix READ optimizedSuffix  NOTIFY configChanged)
+    Q_PROPERTY(bool    optimizerEnabled  READ optimizerEnabled  NOTIFY configChanged)
+    Q_PROPERTY(int     optimizerNiceness READ optimizerNiceness NOTIFY configChanged)
+    Q_PROPERTY(int     optimizerJobs     READ optimizerJobs     NOTIFY configChanged)
+    Q_PROPERTY(int     acceptMaxBitrateKbps READ acceptMaxBitrateKbps NOTIFY configChanged)
+    Q_PROPERTY(QStringList offPeakWindows READ offPeakWindows NOTIFY configChanged)
+    Q_PROPERTY(int     minHeadroomPercent READ minHeadroomPercent NOTIFY configChanged)
+    Q_PROPERTY(bool    prerollEnabled  READ prerollEnabled   NOTIFY configChanged)
+    Q_PROPERTY(int     quarantineAfterFailures READ quarantineAfterFailures NOTIFY configChanged)
+    Q_PROPERTY(QString occlusionPolicy READ occlusionPolicy  NOTIFY configChanged)
+    Q_PROPERTY(int     readaheadBudgetMBps READ readaheadBudgetMBps NOTIFY configChanged)
+    Q_PROPERTY(int     readaheadHeadMB     READ readaheadHeadMB     NOTIFY configChanged)
+    Q_PROPERTY(int     readaheadWholeFileMB READ readaheadWholeFileMB NOTIFY configChanged)
+    Q_PROPERTY(double  decodeCapacity  READ decodeCapacity   NOTIFY configChanged)
+    Q_PROPERTY(double  decodeSoftwareMaxCost READ decodeSoftwareMaxCost NOTIFY configChanged)
+    Q_PROPERTY(int     cacheBudgetMB   READ cacheBudgetMB    NOTIFY configChanged)
 
 public:
     explicit Config(QObject *parent = nullptr);
@@ -42,10 +63,32 @@ public:
     int     imageDurationMs() const;
     QString playlistRoot() const;
     QString logPath() const;
+    QString dataPath() const;
     int     targetWidth() const;
     int     targetHeight() const;
+    QString renderMode() const;
     bool    audioEnabled() const;
+    bool    watchPlaylists() const;
+    bool    sniffMediaTypes() const;
     QString optimizedSuffix() const;
+    bool    optimizerEnabled() const;
+    int     optimizerNiceness() const;
+    int     optimizerJobs() const;
+    int     acceptMaxBitrateKbps() const;
+    QStringList offPeakWindows() const;
+    int     minHeadroomPercent() const;
+    bool    prerollEnabled() const;
+    int     quarantineAfterFailures() const;
+    QString occlusionPolicy() const;
+    int     readaheadBudgetMBps() const;
+    int     readaheadHeadMB() const;
+    int     readaheadWholeFileMB() const;
+    double  decodeCapacity() const;
+    double  decodeSoftwareMaxCost() const;
+    int     cacheBudgetMB() const;
+
+    // Per-zone libVLC media options from [VlcOptions] (e.g. main=":avcodec-hw=none")
+    QStringList vlcOptions(const QString &zoneName) const;
 
     // Full config as a variant map (for QML debugging)
     Q_INVOKABLE QVariantMap toMap() const;
@@ -61,10 +104,30 @@ private:
     int     m_imageDurationMs = 10000;
     QString m_playlistRoot;
     QString m_logPath;
+    QString m_dataPath;
     int     m_targetWidth     = 1920;
     int     m_targetHeight    = 1080;
+    QString m_renderMode      = "native";   // native | scenegraph
     bool    m_audioEnabled    = false;
+    bool    m_watchPlaylists  = true;
+    bool    m_sniffMediaTypes = false;      // Reads each new or changed file
     QString m_optimizedSuffix = "_optimized";
+    bool    m_optimizerEnabled  = true;
+    int     m_optimizerNiceness = 19;       // HandBrake CPU priority (0-19)
+    int     m_optimizerJobs     = 0;        // Parallel encodes, 0 = from CPUs/quota
+    int     m_acceptMaxBitrateKbps = 20000; // HEVC up to this is kept as-is, 0 = any
+    QStringList m_offPeakWindows;           // "HH:mm-HH:mm"; encodes run freely inside
+    int     m_minHeadroomPercent = 30;      // Outside them: playback headroom needed, 0 = none
+    bool    m_prerollEnabled  = true;
+    int     m_quarantineAfterFailures = 3;
+    QString m_occlusionPolicy = "pause";    // pause | release | none
+    int     m_readaheadBudgetMBps  = 8;     // 0 = no readahead
+    int     m_readaheadHeadMB      = 16;
+    int     m_readaheadWholeFileMB = 48;
+    double  m_decodeCapacity        = 4.0;  // 1080p30 units (4K30 = 4.0)
+    double  m_decodeSoftwareMaxCost = 1.0;  // Over budget: software decode up to this
+    int     m_cacheBudgetMB   = 0;      // 0 = derive from cgroup memory.max
+    QHash<QString, QStringList> m_vlcOptions;
 };
 
 #endif // CONFIG_H
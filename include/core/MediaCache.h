@@ -0,0 +1,95 @@
+#ifndef MEDIACACHE_H
+#define MEDIACACHE_H
+
+#include <QObject>
+#include <QString>
+#include <QImage>
+#include <QCache>
+#include <QMutex>
+#include <QTimer>
+#include <QVariantMap>
+
+#include "core/Models.h"
+
+/**
+ * MediaCache - Process-wide, memory-budgeted LRU for decoded media.
+ *
+ * Holds decoded zone images (ImageDecodeService) and probe results
+ * (MediaProbeService) under one byte budget, so short playlists that
+ * cycle the same files all day are decoded once.
+ *
+ * Budget: [Cache] budgetMB in config.ini; 0 derives it from the service's
+ * cgroup memory.max (MemoryMax= in nctv-player.service) — one eighth of
+ * it, or 64 MB when unlimited. The cgroup usage without its page cache
+ * (memory.current − memory.stat file) is polled and the cache halves
+ * itself when the service nears its limit.
+ *
+ * Hit/miss counters are exposed via stats() for sizing per deployment.
+ * They count lookups that serve a request; the contains*() checks made
+ * while prefetching or batch-probing are not counted. statsChanged() is
+ * coalesced per event-loop pass.
+ * Thread-safe; singleton like MediaIndex.
+ */
+class MediaCache : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QVariantMap stats READ stats NOTIFY statsChanged)
+
+public:
+    static MediaCache *instance();
+
+    /// Byte budget; megabytes <= 0 selects the cgroup-derived default.
+    void   setBudgetMB(int megabytes);
+    qint64 budgetBytes() const;
+    qint64 usedBytes() const;
+
+    // ── Decoded images ──
+    bool lookupImage(const QString &key, QImage &image);
+    bool containsImage(const QString &key) const;
+    void insertImage(const QString &key, const QImage &image);
+
+    // ── Probe results ──
+    bool lookupMediaInfo(const QString &filePath, nctv::MediaInfo &info);
+    bool containsMediaInfo(const QString &filePath) const;
+    void insertMediaInfo(const QString &filePath, const nctv::MediaInfo &info);
+
+    /// Evict least recently used entries down to the given share of the budget.
+    Q_INVOKABLE void trim(double keepFraction = 0.5);
+
+    quint64     hits() const;
+    quint64     misses() const;
+    QVariantMap stats() const;
+
+signals:
+    void statsChanged();
+
+private:
+    explicit MediaCache(QObject *parent = nullptr);
+    ~MediaCache() override = default;
+
+    struct Entry {
+        QImage          image;
+        nctv::MediaInfo info;
+    };
+
+    bool lookup(const QString &key, Entry &entry);
+    bool contains(const QString &key) const;
+    void insert(const QString &key, Entry *entry, qint64 cost);
+    void notifyStatsChanged();
+    void checkMemoryPressure();
+
+    static qint64 defaultBudgetBytes();
+
+    static MediaCache *s_instance;
+
+    mutable QMutex         m_mutex;
+    QCache<QString, Entry> m_entries;
+    quint64                m_hits   = 0;
+    quint64                m_misses = 0;
+    bool                   m_statsPending = false;
+
+    QTimer                 m_pressureTimer;
+};
+
+#endif // MEDIACACHE_H
@@ -0,0 +1,85 @@
+#ifndef MEDIAINDEX_H
+#define MEDIAINDEX_H
+
+#include <QObject>
+#include <QString>
+#include <QHash>
+#include <QFile>
+#include <QMutex>
+#include <QTimer>
+#include <QThreadPool>
+
+#include "core/Models.h"
+
+/**
+ * MediaIndex - Persistent on-disk cache of probed media metadata.
+ *
+ * Entries are keyed by absolute path and validated against file size and
+ * modification time, so only new or changed files need a libVLC parse.
+ *
+ * File layout (native endian, written atomically via QSaveFile):
+ *   Header  { magic 'NCMI', version, recordCount, stringBytes }
+ *   Record  × recordCount, sorted by 64-bit FNV-1a hash of the UTF-8 path
+ *   String table (UTF-8 paths, referenced by offset/length)
+ *
+ * The file is memory-mapped on open() and searched in place; new results
+ * are kept in an in-memory overlay and merged on the next save(). open()
+ * rejects a file whose records point outside its string table; save()
+ * drops the entries of files that no longer exist. The existence checks
+ * and the write run on a worker, outside the lock.
+ *
+ * Thread-safe: probe workers read and insert concurrently.
+ */
+class MediaIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    static MediaIndex *instance();
+
+    /// Map the index file. A missing or incompatible file yields an empty index.
+    bool open(const QString &filePath);
+
+    /// Lookup with known file attributes (no filesystem access).
+    bool lookup(const QString &filePath, qint64 fileSize, qint64 mtimeMs, nctv::MediaInfo &info) const;
+
+    /// Lookup that stats the file to validate the entry.
+    bool lookup(const QString &filePath, nctv::MediaInfo &info) const;
+
+    void insert(const QString &filePath, qint64 fileSize, qint64 mtimeMs, const nctv::MediaInfo &info);
+
+    /// Write overlay + mapped entries back to disk in the background (also
+    /// runs on a debounce timer).
+    Q_INVOKABLE void save();
+
+    int entryCount() const;
+
+private:
+    explicit MediaIndex(QObject *parent = nullptr);
+    ~MediaIndex() override;
+
+    struct Entry {
+        qint64          fileSize = 0;
+        qint64          mtimeMs  = 0;
+        nctv::MediaInfo info;
+    };
+
+    bool findMapped(const QString &filePath, Entry &entry) const;
+    void unmap();
+
+    static MediaIndex *s_instance;
+
+    mutable QMutex         m_mutex;
+    QString                m_filePath;
+    QFile                  m_file;
+    const uchar           *m_map         = nullptr;
+    qint64                 m_mapSize     = 0;
+    quint32                m_recordCount = 0;
+
+    QHash<QString, Entry>  m_overlay;     // Probed since the last save
+    QTimer                 m_saveTimer;
+    QThreadPool            m_savePool;    // One writer at a time
+    bool                   m_saving      = false;
+};
+
+#endif // MEDIAINDEX_H
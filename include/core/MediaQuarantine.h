@@ -0,0 +1,74 @@
+#ifndef MEDIAQUARANTINE_H
+#define MEDIAQUARANTINE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+
+#include "core/Models.h"
+
+/**
+ * MediaQuarantine - Failure tracking for media that will not play.
+ *
+ * Every playback failure puts the file into back-off: it is skipped for
+ * baseDelay × 2^(failures-1), capped at 30 minutes. A file that fails
+ * `threshold` times in a row is quarantined and skipped until it is
+ * replaced (its size changes) or the list is cleared. A video that plays
+ * to its end, or for a while (ZonePlayer), clears the file's record.
+ *
+ * Quarantined files are persisted as JSON under dataPath, so a broken
+ * file does not cost a failed start per zone on every boot. Back-off
+ * state is kept in memory only.
+ *
+ * Qt thread only; singleton like MediaIndex.
+ */
+class MediaQuarantine : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QStringList quarantined READ quarantined NOTIFY quarantineChanged)
+
+public:
+    static MediaQuarantine *instance();
+
+    /// Load the persisted list; later changes are written back to filePath.
+    bool open(const QString &filePath);
+    void setPolicy(int baseDelayMs, int threshold);
+
+    /// Not quarantined and not backing off.
+    bool isPlayable(const nctv::MediaItem &item) const;
+    bool isQuarantined(const nctv::MediaItem &item) const;
+
+    void recordFailure(const nctv::MediaItem &item);
+    void recordSuccess(const QString &filePath);
+
+    QStringList quarantined() const;
+    Q_INVOKABLE void clear();
+
+signals:
+    void quarantineChanged();
+
+private:
+    explicit MediaQuarantine(QObject *parent = nullptr);
+    ~MediaQuarantine() override = default;
+
+    struct Record {
+        qint64 fileSize    = 0;
+        int    failures    = 0;
+        qint64 retryAtMs   = 0;      // Back-off end (ms since epoch)
+        bool   quarantined = false;
+    };
+
+    const Record *recordFor(const nctv::MediaItem &item) const;
+    void save() const;
+
+    static MediaQuarantine *s_instance;
+
+    QString                 m_filePath;
+    QHash<QString, Record>  m_records;
+    int                     m_baseDelayMs = 5000;
+    int                     m_threshold   = 3;
+};
+
+#endif // MEDIAQUARANTINE_H
@@ -0,0 +1,64 @@
+#ifndef MEDIATYPES_H
+#define MEDIATYPES_H
+
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+#include <QByteArray>
+
+#include "core/Models.h"
+
+/**
+ * MediaTypes - The one registry of supported media formats.
+ *
+ * kExtensions is the compile-time table of playable file extensions;
+ * fromExtension() answers from a hash built once from it. sniff() reads
+ * the container / image signature ("magic bytes") from the first few
+ * hundred bytes, so a misnamed file (a JPEG saved as .mp4, an MP4 without
+ * an extension) is classified by what it is rather than by its name.
+ *
+ * Used by PlaylistService (scan-time classification) and VideoOptimizer.
+ * Thread-safe: lookups only read immutable tables.
+ */
+namespace nctv {
+namespace MediaTypes {
+
+struct ExtensionEntry {
+    const char *extension;      // Lower case, without the dot
+    MediaType   type;
+};
+
+inline constexpr ExtensionEntry kExtensions[] = {
+    // Video
+    { "mp4",  MediaType::Video }, { "mkv",  MediaType::Video }, { "avi",  MediaType::Video },
+    { "mov",  MediaType::Video }, { "wmv",  MediaType::Video }, { "flv",  MediaType::Video },
+    { "webm", MediaType::Video }, { "ts",   MediaType::Video }, { "m4v",  MediaType::Video },
+    { "mpg",  MediaType::Video }, { "mpeg", MediaType::Video },
+    // Image
+    { "jpg",  MediaType::Image }, { "jpeg", MediaType::Image }, { "png",  MediaType::Image },
+    { "bmp",  MediaType::Image }, { "gif",  MediaType::Image }, { "webp", MediaType::Image },
+    { "svg",  MediaType::Image },
+};
+
+/// Bytes read from the start of a file for sniff() (covers two MPEG-TS packets)
+inline constexpr int kSniffBytes = 192;
+
+/// Case-insensitive, constant-time extension lookup ("MP4" → Video).
+MediaType fromExtension(QStringView extension);
+
+/// Extensions registered for a type (e.g. for file dialogs or filters).
+QStringList extensions(MediaType type);
+
+/// Type from a file header; Unknown when no known signature matches.
+MediaType sniff(const QByteArray &header);
+MediaType sniffFile(const QString &filePath);
+
+/// Scan-time classification: by extension, corrected by the content
+/// signature when sniffContent is set and the signature is recognised.
+/// Only registered extensions and extension-less files are sniffed.
+MediaType classify(const QString &filePath, QStringView extension, bool sniffContent);
+
+} // namespace MediaTypes
+} // namespace nctv
+
+#endif // MEDIATYPES_H
@@ -4,6 +4,8 @@
 #include <QString>
 #include <QStringList>
 #include <QRect>
+#include <QSize>
+#include <QMetaType>
 
 /**
  * Models.h - Core data structures used throughout the application.
@@ -40,12 +42,97 @@ inline QString zoneIdToFolderName(ZoneId zone) {
     return QStringLiteral("playlist-") + zoneIdToString(zone);
 }
 
+// ── Probed Media Metadata ──
+struct MediaInfo {
+    unsigned width      = 0;
+    unsigned height     = 0;
+    QString  codec;             // FourCC of the primary video track (e.g. "hevc", "h264")
+    int      profile    = -1;   // Codec profile as reported by libVLC (-1 = unknown)
+    qint64   bitrate    = 0;    // Video bits/s (stream, else file average); 0 = unknown
+    qint64   durationMs = 0;
+    double   frameRate  = 0.0;
+    bool     valid      = false;
+    bool     acceptedOptimized = false;  // Already meets the optimizer's target (kept as-is)
+
+    // 4K content is played as a fullscreen overlay instead of embedded
+    bool is4K() const { return width >= 3000; }
+};
+
+// ── Rendition ──
+// A zone-sized encode of a playlist item (VideoOptimizer), fitted into
+// maxWidth × maxHeight. Probed metadata is derived and not compared.
+struct Rendition {
+    QString   filePath;
+    QSize     box;
+    qint64    fileSize = 0;
+    qint64    mtimeMs  = 0;
+    MediaInfo info;
+
+    bool operator==(const Rendition &other) const {
+        return filePath == other.filePath && box == other.box && fileSize == other.fileSize
+            && mtimeMs == other.mtimeMs;
+    }
+    bool operator!=(const Rendition &other) const { return !(*this == other); }
+};
+
+// Optimizer output names: "<base><suffix>" is a full-frame encode,
+// "<base><suffix>_<W>x<H>" one fitted to a zone of at most W×H
+inline QString renditionSuffix(const QString &suffix, const QSize &box) {
+    if (!box.isValid())
+        return suffix;
+    return suffix + QStringLiteral("_%1x%2").arg(box.width()).arg(box.height());
+}
+
+// Splits an optimizer output stem into the source's stem and its box
+// (invalid for full-frame). False for anything else, i.e. a raw file.
+inline bool parseOptimizedStem(QStringView stem, QStringView suffix, QStringView *key, QSize *box) {
+    if (stem.endsWith(suffix)) {
+        *key = stem.chopped(suffix.size());
+        *box = QSize();
+        return true;
+    }
+
+    const qsizetype underscore = stem.lastIndexOf(QLatin1Char('_'));
+    if (underscore < 0)
+        return false;
+    const QStringView base = stem.left(underscore);
+    const QStringView tag  = stem.mid(underscore + 1);
+    const qsizetype x = tag.indexOf(QLatin1Char('x'));
+    if (x <= 0 || !base.endsWith(suffix))
+        return false;
+
+    bool widthOk = false, heightOk = false;
+    const int width  = tag.left(x).toInt(&widthOk);
+    const int height = tag.mid(x + 1).toInt(&heightOk);
+    if (!widthOk || !heightOk || width <= 0 || height <= 0)
+        return false;
+
+    *key = base.chopped(suffix.size());
+    *box = QSize(width, height);
+    return true;
+}
+
 // ── Media Item ──
+// One playlist entry, classified once at scan time (PlaylistService)
 struct MediaItem {
     QString   filePath;
     MediaType type       = MediaType::Unknown;
     bool      optimized  = false;
     qint64    fileSize   = 0;
+    qint64    mtimeMs    = 0;   // As listed; a rescan revalidates against it
+    MediaInfo info;             // Probed metadata (videos); invalid until known
+    QList<Rendition> renditions; // Zone-sized encodes of the same source
+
+    bool isVideo() const { return type == MediaType::Video; }
+    bool isImage() const { return type == MediaType::Image; }
+
+    // Same file on disk; probed metadata is derived and not compared
+    bool operator==(const MediaItem &other) const {
+        return filePath == other.filePath && type == other.type
+            && optimized == other.optimized && fileSize == other.fileSize
+            && mtimeMs == other.mtimeMs && renditions == other.renditions;
+    }
+    bool operator!=(const MediaItem &other) const { return !(*this == other); }
 };
 
 // ── Zone Definition (layout coordinates) ──
@@ -68,6 +155,19 @@ inline QList<ZoneDefinition> defaultZoneDefinitions() {
     };
 }
 
+// Default zone definitions scaled to another screen size (the QML layout
+// uses the same proportions)
+inline QList<ZoneDefinition> zoneDefinitionsFor(int screenWidth, int screenHeight) {
+    QList<ZoneDefinition> zones = defaultZoneDefinitions();
+    for (ZoneDefinition &zone : zones) {
+        zone.x      = zone.x      * screenWidth  / 1920;
+        zone.y      = zone.y      * screenHeight / 1080;
+        zone.width  = zone.width  * screenWidth  / 1920;
+        zone.height = zone.height * screenHeight / 1080;
+    }
+    return zones;
+}
+
 // ── Application State ──
 enum class AppState {
     Splash,
@@ -77,4 +177,7 @@ enum class AppState {
 
 } // namespace nctv
 
+Q_DECLARE_METATYPE(nctv::MediaInfo)
+Q_DECLARE_METATYPE(nctv::MediaItem)
+
 #endif // MODELS_H
@@ -0,0 +1,76 @@
+#ifndef ZONEPLAYLISTMODEL_H
+#define ZONEPLAYLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QVariantMap>
+
+#include "core/Models.h"
+
+/**
+ * ZonePlaylistModel - The resolved playlist of one zone as MediaItems.
+ *
+ * Owned by PlaylistService, one per zone. Items arrive fully classified
+ * from the scan (type, size, optimized flag, probed metadata when the
+ * MediaIndex already knows the file), so ZonePlayer never parses paths
+ * on the playback path. Metadata probed later is merged in place via
+ * updateInfo().
+ *
+ * Exposed to QML as a list model (roles below) and passed to
+ * ZonePlayer::setPlaylist().
+ */
+class ZonePlaylistModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QString zoneName READ zoneName CONSTANT)
+    Q_PROPERTY(int     count    READ count    NOTIFY countChanged)
+
+public:
+    enum Roles {
+        FilePathRole = Qt::UserRole + 1,
+        FileNameRole,
+        MediaTypeRole,      // "video" | "image" | "unknown"
+        OptimizedRole,
+        FileSizeRole,
+        WidthRole,
+        HeightRole,
+        CodecRole,
+        DurationRole,
+        Is4KRole,
+        ProbedRole
+    };
+
+    explicit ZonePlaylistModel(const QString &zoneName, QObject *parent = nullptr);
+
+    // ── QAbstractListModel ──
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // ── Accessors ──
+    QString zoneName() const;
+    int     count() const;
+    const QList<nctv::MediaItem> &items() const;
+    QStringList filePaths() const;
+    int     indexOf(const QString &filePath) const;
+
+    Q_INVOKABLE QVariantMap get(int row) const;
+
+    // ── Updates (PlaylistService) ──
+    /// Replace the list; returns false (and emits nothing) when unchanged.
+    bool setItems(const QList<nctv::MediaItem> &items);
+    void updateInfo(const QString &filePath, const nctv::MediaInfo &info);
+
+signals:
+    void countChanged();
+
+private:
+    QString                 m_zoneName;
+    QList<nctv::MediaItem>  m_items;
+    QHash<QString, int>     m_rows;      // filePath → row
+};
+
+#endif // ZONEPLAYLISTMODEL_H
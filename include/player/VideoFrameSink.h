@@ -0,0 +1,58 @@
+#ifndef VIDEOFRAMESINK_H
+#define VIDEOFRAMESINK_H
+
+#include <QObject>
+#include <QImage>
+#include <QMutex>
+#include <vlc/vlc.h>
+
+/**
+ * VideoFrameSink - Receives decoded frames from one libVLC media player.
+ *
+ * Installed through libvlc_video_set_callbacks() when a zone renders via
+ * the Qt scene graph instead of a native child window. VLC converts to
+ * RV32 and writes into a small ring of frame buffers that are allocated
+ * once per video size and reused for every frame.
+ *
+ * Buffer roles (guarded by m_mutex):
+ *   ready - last complete frame, not yet picked up
+ *   front - frame handed to the render thread (never written)
+ *   the remaining buffer is locked by the VLC vout thread for decoding
+ *
+ * frameReady() is emitted from the vout thread; connect it queued.
+ */
+class VideoFrameSink : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit VideoFrameSink(QObject *parent = nullptr);
+    ~VideoFrameSink() override = default;
+
+    /// Route the player's video output into this sink (before playback).
+    void attach(libvlc_media_player_t *player);
+
+    /// Latest frame for the render thread. Sets *isNew when it changed
+    /// since the previous call. The image shares the sink's buffer.
+    QImage takeFrame(bool *isNew = nullptr);
+
+signals:
+    void frameReady();
+
+private:
+    static unsigned setupCallback(void **opaque, char *chroma, unsigned *width, unsigned *height,
+                                  unsigned *pitches, unsigned *lines);
+    static void     cleanupCallback(void *opaque);
+    static void    *lockCallback(void *opaque, void **planes);
+    static void     unlockCallback(void *opaque, void *picture, void *const *planes);
+    static void     displayCallback(void *opaque, void *picture);
+
+    static constexpr int kBufferCount = 3;
+
+    QMutex  m_mutex;
+    QImage  m_buffers[kBufferCount];
+    int     m_ready   = -1;
+    int     m_front   = -1;
+};
+
+#endif // VIDEOFRAMESINK_H
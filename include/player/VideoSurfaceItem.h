@@ -0,0 +1,51 @@
+#ifndef VIDEOSURFACEITEM_H
+#define VIDEOSURFACEITEM_H
+
+#include <QQuickItem>
+#include <QPointer>
+#include <QSharedPointer>
+
+#include "player/VideoFrameSink.h"
+
+class ZonePlayer;
+
+/**
+ * VideoSurfaceItem - Scene graph video layer for one zone.
+ *
+ * Used when [Display] renderMode=scenegraph: the zone's ZonePlayer decodes
+ * into a VideoFrameSink and this item uploads the latest frame into a
+ * texture node (one texture per frame size, updated in place), so video
+ * composes with the QML Image layers (and any transitions above it) in
+ * the normal render pass — no native child window, no X11 window handle.
+ *
+ * Registered to QML as VideoSurface (import Nctv.Video 1.0). With the
+ * native render path the player exposes no sink and the item draws nothing.
+ */
+class VideoSurfaceItem : public QQuickItem
+{
+    Q_OBJECT
+
+    Q_PROPERTY(ZonePlayer *player READ player WRITE setPlayer NOTIFY playerChanged)
+
+public:
+    explicit VideoSurfaceItem(QQuickItem *parent = nullptr);
+    ~VideoSurfaceItem() override = default;
+
+    ZonePlayer *player() const;
+    void        setPlayer(ZonePlayer *player);
+
+signals:
+    void playerChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+
+private slots:
+    void onActiveFrameSinkChanged();
+
+private:
+    QPointer<ZonePlayer>            m_player;
+    QSharedPointer<VideoFrameSink>  m_sink;
+};
+
+#endif // VIDEOSURFACEITEM_H
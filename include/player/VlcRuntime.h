@@ -0,0 +1,57 @@
+#ifndef VLCRUNTIME_H
+#define VLCRUNTIME_H
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QWeakPointer>
+#include <vlc/vlc.h>
+
+/**
+ * VlcRuntime - Single, reference-counted libVLC instance shared by all zones.
+ *
+ * libvlc_new() loads the plugin bank and allocates the core state; doing it
+ * once instead of per ZonePlayer saves start-up time and RSS. Every holder
+ * of acquire() keeps the instance alive; it is released with the last one.
+ *
+ * Media players are created through the runtime so libVLC log messages can
+ * be tagged with the zone that owns the emitting player. Per-zone options
+ * are applied to each media (":option") instead of the shared instance.
+ */
+class VlcRuntime
+{
+public:
+    static QSharedPointer<VlcRuntime> acquire();
+    ~VlcRuntime();
+
+    bool               isValid() const;
+    libvlc_instance_t *instance() const;
+
+    // ── Media players (registered for log routing) ──
+    libvlc_media_player_t *createPlayer(const QString &zoneName);
+    void                   releasePlayer(libvlc_media_player_t *player);
+
+    // ── Media ──
+    libvlc_media_t *createMedia(const QString &filePath, const QStringList &options = {}) const;
+
+private:
+    VlcRuntime();
+    Q_DISABLE_COPY(VlcRuntime)
+
+    QString zoneForObject(quintptr objectId) const;
+
+    static void logCallback(void *data, int level, const libvlc_log_t *ctx,
+                            const char *fmt, va_list args);
+
+    libvlc_instance_t *m_instance = nullptr;
+
+    mutable QMutex             m_mutex;
+    QHash<quintptr, QString>   m_playerZones;   // player object → zone name
+
+    static QMutex                   s_mutex;
+    static QWeakPointer<VlcRuntime> s_shared;
+};
+
+#endif // VLCRUNTIME_H
@@ -0,0 +1,21 @@
+#ifndef ZONEIMAGEPROVIDER_H
+#define ZONEIMAGEPROVIDER_H
+
+#include <QQuickImageProvider>
+
+/**
+ * ZoneImageProvider - Serves zone images to QML (image://zone/...).
+ *
+ * Resolves ZonePlayer's provider URLs through ImageDecodeService, so the
+ * Image element receives a picture already decoded off-thread at the
+ * zone's size. Requests always run on QML's loader threads.
+ */
+class ZoneImageProvider : public QQuickImageProvider
+{
+public:
+    ZoneImageProvider();
+
+    QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override;
+};
+
+#endif // ZONEIMAGEPROVIDER_H
@@ -6,19 +6,44 @@
 #include <QTimer>
 #include <QRect>
 #include <QWindow>
+#include <QSharedPointer>
+#include <QHash>
+#include <QElapsedTimer>
 #include <vlc/vlc.h>
 
+#include "core/Models.h"
+#include "core/ZonePlaylistModel.h"
+#include "player/VlcRuntime.h"
+#include "player/VideoFrameSink.h"
+
 /**
  * ZonePlayer - C++ wrapper around libVLC for a single display zone.
  *
  * Handles both video and image playback:
  *  - For videos: libVLC renders hardware-accelerated frames directly
- *    into the zone's screen coordinates.
- *  - For images: Hides the VLC layer and exposes QML-native Image source
- *    via Q_PROPERTY, with a configurable display duration timer.
+ *    into the zone's screen coordinates, or — with the scene graph
+ *    render mode — into a VideoFrameSink drawn by a VideoSurfaceItem.
+ *  - For images: Hides the VLC layer and exposes an image://zone/ source
+ *    via Q_PROPERTY, with a configurable display duration timer. The next
+ *    image is decoded ahead, at zone size, by ImageDecodeService.
+ *  - The next video is read into the page cache ahead of its start by
+ *    ReadaheadService, within the shared I/O budget.
+ *  - Of an item's zone-sized renditions (VideoOptimizer), the smallest
+ *    that still covers the zone's geometry is played; none fitting, the
+ *    item's own file. A geometry change re-selects at the next loop.
+ *  - Every video start and pre-roll asks DecodeBudget for hardware
+ *    decoder capacity; over budget it decodes in software, or holds the
+ *    previous frame until another zone frees capacity.
+ *
+ * While `occluded` (another zone's 4K overlay covers this one), the zone
+ * suspends: its video is paused or released, the image timer and pre-roll
+ * are held, and everything resumes where it was once the overlay ends.
+ * Either way its decoder lease is handed back, and a 4K start announces
+ * is4K before asking DecodeBudget, so the overlay is admitted at once.
  *
  * Each zone (background, main, horizontal, vertical) gets its own
- * ZonePlayer instance.
+ * ZonePlayer instance. All of them draw their media players from one
+ * shared VlcRuntime.
  */
 class ZonePlayer : public QObject
 {
@@ -33,6 +58,7 @@ class ZonePlayer : public QObject
     Q_PROPERTY(int     currentIndex      READ currentIndex      NOTIFY currentIndexChanged)
     Q_PROPERTY(int     playlistSize      READ playlistSize      NOTIFY playlistSizeChanged)
     Q_PROPERTY(bool    is4K              READ is4K              NOTIFY is4KChanged)
+    Q_PROPERTY(bool    occluded          READ occluded  WRITE setOccluded NOTIFY occludedChanged)
 
 public:
     explicit ZonePlayer(const QString &zoneName, QObject *parent = nullptr);
@@ -47,15 +73,26 @@ public:
     int     currentIndex() const;
     int     playlistSize() const;
     bool    is4K() const;
+    bool    occluded() const;
+
+    // Frame source for VideoSurfaceItem (null unless a scene graph video is active)
+    QSharedPointer<VideoFrameSink> activeFrameSink() const;
 
     // ── Configuration ──
     Q_INVOKABLE void setImageDuration(int ms);
     Q_INVOKABLE void setGeometry(int x, int y, int w, int h);
     Q_INVOKABLE void setWindowId(quintptr winId);
     Q_INVOKABLE void setZOrder(int z);
+    Q_INVOKABLE void setPrerollEnabled(bool enabled);
+    Q_INVOKABLE void setRetryInterval(int ms);
+    Q_INVOKABLE void setVlcOptions(const QStringList &options);
+    Q_INVOKABLE void setRenderMode(const QString &mode);
+    Q_INVOKABLE void setOcclusionPolicy(const QString &policy);
+    void setOccluded(bool occluded);
 
     // ── Playlist ──
-    Q_INVOKABLE void setPlaylist(const QStringList &files);
+    Q_INVOKABLE void setPlaylist(ZonePlaylistModel *model);
+    void setPlaylist(const QList<nctv::MediaItem> &items);
     Q_INVOKABLE void play();
     Q_INVOKABLE void stop();
     Q_INVOKABLE void next();
@@ -69,28 +106,74 @@ signals:
     void currentIndexChanged();
     void playlistSizeChanged();
     void is4KChanged();
+    void occludedChanged();
+    void activeFrameSinkChanged();
     void mediaFinished();
     void errorOccurred(const QString &message);
 
 private slots:
     void onImageTimerTimeout();
     void onMediaEndReached();
+    void onMediaFailed();
+    void onRetryTimerTimeout();
+    void onDecodeBudgetRetry();
     void checkVideoResolution();
+    void onProbeFinished(const QString &filePath, const nctv::MediaInfo &info);
 
 private:
+    // Video output modes: embedded in the zone's child window, or 4K fullscreen overlay
+    enum class OutputMode {
+        Embedded,
+        Overlay
+    };
+
+    // What an occluded zone does with its video decoder
+    enum class OcclusionPolicy {
+        None,       // Keep playing
+        Pause,      // Pause in place (decoder stays allocated)
+        Release     // Stop the player; reopen and seek on resume
+    };
+
     // ── Internal helpers ──
     void initVlc();
     void releaseVlc();
+    void applyPlaylist(const QList<nctv::MediaItem> &items);
+    QList<nctv::MediaItem> selectRenditions(const QList<nctv::MediaItem> &items) const;
     void playCurrentItem();
-    void playVideo(const QString &filePath);
+    void playVideo(const nctv::MediaItem &item);
+    void startVideo(const QString &filePath, const nctv::MediaInfo &info);
     void showStaticImage(const QString &filePath);
-    bool isImageFile(const QString &filePath) const;
-    bool isVideoFile(const QString &filePath) const;
-    void getVideoDimensions(libvlc_media_t *media, unsigned &width, unsigned &height);
+    QSize imageTargetSize() const;
+    void prefetchNextItem();
+    int  indexOfPath(const QString &filePath) const;
+    int  nextPlayableIndex(int after) const;
+    void waitForPlayableItem();
+    void waitForDecodeBudget(const QString &filePath, const nctv::MediaInfo &info);
+    void suspendForOcclusion();
+    void resumeFromOcclusion();
+    void attachPlayerEvents(libvlc_media_player_t *player);
+    QStringList mediaOptions(bool hardwareDecode = true) const;
+    QString standbyLease() const;
+
+    // Mode-aware player pool
+    libvlc_media_player_t *createPooledPlayer(OutputMode mode, QWindow *window);
+    void releasePooledPlayer(libvlc_media_player_t *&player);
+    void releaseModePlayers(OutputMode mode);
+    void setActiveFrameSink(libvlc_media_player_t *player);
+
+    // Gapless pre-roll: buffer the next item in a standby player
+    void prerollNext();
+    bool startPrerolled(int index);
+    void parkStandby();
+    void releaseStandby();
 
     // Per-zone native child window management
     void createZoneWindow();
     void destroyZoneWindow();
+    void destroyStandbyWindow();
+    QWindow *createVideoWindow(const QString &objectName);
+    void attachVideoWindow(libvlc_media_player_t *player, QWindow *window);
+    void applyZOrder(QWindow *window);
 
     // libVLC event callback (static, forwarded to instance)
     static void vlcEventCallback(const libvlc_event_t *event, void *userData);
@@ -102,13 +185,37 @@ private:
     bool            m_is4K            = false;
     QString         m_currentImageSrc;
     QString         m_currentMediaPath;
+    QString         m_pendingProbePath;   // Video waiting on MediaProbeService
 
-    QStringList     m_playlist;
+    QList<nctv::MediaItem> m_sourcePlaylist; // As published by PlaylistService
+    QList<nctv::MediaItem> m_playlist;       // Renditions selected for this zone
     int             m_currentIndex    = 0;
 
     int             m_imageDurationMs = 10000;  // Default 10 seconds per image
     QTimer          m_imageTimer;
 
+    // Idle retry while every item is failing or quarantined (MediaQuarantine)
+    int             m_retryIntervalMs = 5000;
+    QTimer          m_retryTimer;
+    QTimer          m_successTimer;       // Clears the failure record after kSuccessPlayMs
+    QString         m_successPath;
+
+    // Occlusion (another zone's 4K overlay covers this one)
+    OcclusionPolicy m_occlusionPolicy  = OcclusionPolicy::Pause;
+    bool            m_occluded         = false;
+    bool            m_suspended        = false;
+    int             m_imageRemainingMs = -1;    // Image timer left at suspend
+    qint64          m_resumePositionMs = -1;    // Video position to seek to (Release)
+    bool            m_restartOnResume  = false; // Current item must be started again
+    bool            m_retryOnResume    = false;
+
+    // Video start delayed by DecodeBudget: retried when capacity frees up,
+    // or every retryIntervalMs until kMaxDecodeWaitMs, then skipped
+    QString         m_budgetWaitPath;
+    nctv::MediaInfo m_budgetWaitInfo;
+    QTimer          m_budgetTimer;
+    QElapsedTimer   m_budgetWaitClock;
+
     // Zone screen geometry for libVLC overlay
     QRect           m_geometry;
     quintptr        m_windowId        = 0;
@@ -117,14 +224,32 @@ private:
     // Per-zone native child window for libVLC rendering
     QWindow        *m_zoneWindow      = nullptr;
 
-    // libVLC handles
-    libvlc_instance_t     *m_vlcInstance = nullptr;
-    libvlc_media_player_t *m_vlcPlayer   = nullptr;
+    // libVLC handles (instance shared by all zones)
+    QSharedPointer<VlcRuntime> m_vlc;
+    QStringList            m_vlcOptions;     // Per-zone ":option" list applied to each media
+    libvlc_media_player_t *m_vlcPlayer   = nullptr;   // Active player (one of the pooled players)
     libvlc_event_manager_t *m_vlcEvents  = nullptr;
 
-    // Supported extensions
-    static const QStringList s_imageExtensions;
-    static const QStringList s_videoExtensions;
+    // Player pool: each player is configured for its output mode once and
+    // reused while consecutive items need that mode
+    libvlc_media_player_t *m_embeddedPlayer = nullptr;   // Renders into m_zoneWindow
+    libvlc_media_player_t *m_overlayPlayer  = nullptr;   // 4K fullscreen overlay
+    OutputMode             m_outputMode     = OutputMode::Embedded;
+
+    // Scene graph render mode: embedded players decode into frame sinks
+    // instead of the native child windows (4K keeps the overlay player)
+    bool                   m_sceneGraphOutput = false;
+    QHash<libvlc_media_player_t *, QSharedPointer<VideoFrameSink>> m_frameSinks;
+    QSharedPointer<VideoFrameSink> m_activeSink;
+
+    // Standby slot: the next video, opened and paused on its first frame
+    // in a hidden window so the swap on end-of-media shows no black gap.
+    // After a swap the previous embedded player is parked here for reuse.
+    bool                   m_prerollEnabled = true;
+    libvlc_media_player_t *m_standbyPlayer  = nullptr;
+    QWindow               *m_standbyWindow  = nullptr;
+    QString                m_standbyPath;
+    int                    m_standbyIndex   = -1;
 };
 
 #endif // ZONEPLAYER_H
@@ -0,0 +1,79 @@
+#ifndef DECODEBUDGET_H
+#define DECODEBUDGET_H
+
+#include <QObject>
+#include <QString>
+#include <QHash>
+
+#include "core/Models.h"
+
+/**
+ * DecodeBudget - Arbitrates the hardware video decoder between zones.
+ *
+ * The Pi's decoder sustains one 4K HEVC stream or a few 1080p ones; four
+ * zones asking for it independently end in software fallback or decoder
+ * errors. Every video start (and every pre-roll) asks for a lease sized
+ * from its probed resolution, frame rate and codec, in 1080p30 units:
+ *
+ *   1920×1080 @ 30  → 1.0        3840×2160 @ 30 → 4.0
+ *
+ * A start that fits the configured capacity is admitted to the hardware
+ * decoder. One that does not is downgraded to software decoding when it
+ * is cheap enough (cost <= softwareMaxCost), and otherwise delayed until
+ * another zone releases its lease (capacityFreed).
+ *
+ * Codecs without a hardware decoder take no budget; unprobed items count
+ * as one 1080p30 stream. Leases are keyed by owner ("main",
+ * "main/standby"); a new lease replaces the owner's old one.
+ *
+ * Qt thread only; singleton like WindowService.
+ */
+class DecodeBudget : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(double load     READ load     NOTIFY loadChanged)
+    Q_PROPERTY(double capacity READ capacity NOTIFY loadChanged)
+
+public:
+    enum class Decision {
+        Hardware,   // Admitted (or needs no hardware budget)
+        Software,   // Over budget, decode in software
+        Delay       // Over budget and too expensive for software: wait
+    };
+
+    static DecodeBudget *instance();
+
+    void setCapacity(double capacity, double softwareMaxCost);
+
+    /// Cost in 1080p30 units; 0 for codecs without hardware support, 1 if unprobed.
+    static double costOf(const nctv::MediaInfo &info);
+
+    Decision acquire(const QString &owner, const nctv::MediaInfo &info);
+    void     release(const QString &owner);
+    /// Move a lease to another owner (pre-rolled player becomes the active one).
+    void     transfer(const QString &from, const QString &to);
+
+    double load() const;
+    double capacity() const;
+
+signals:
+    void loadChanged();
+    void capacityFreed();
+
+private:
+    explicit DecodeBudget(QObject *parent = nullptr);
+    ~DecodeBudget() override = default;
+
+    void notifyCapacityFreed();
+
+    static DecodeBudget *s_instance;
+
+    QHash<QString, double> m_leases;     // owner → cost
+    double m_load            = 0.0;
+    double m_capacity        = 4.0;
+    double m_softwareMaxCost = 1.0;
+    bool   m_notifyPending   = false;
+};
+
+#endif // DECODEBUDGET_H
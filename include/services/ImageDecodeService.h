@@ -0,0 +1,65 @@
+#ifndef IMAGEDECODESERVICE_H
+#define IMAGEDECODESERVICE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QSize>
+#include <QImage>
+#include <QSet>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThreadPool>
+
+/**
+ * ImageDecodeService - Off-thread, zone-sized still image decoding.
+ *
+ * Playlist images are often far larger than the zone showing them. Images
+ * are decoded with QImageReader::setScaledSize() straight to the zone size
+ * (JPEG scales during decode), so neither the decode time nor the texture
+ * grows with the source resolution.
+ *
+ * ZonePlayer calls prefetch() for the upcoming image while the current
+ * item is on screen; ZoneImageProvider then picks up the finished image
+ * when QML requests it. Decoded images are retained in MediaCache, so a
+ * looping playlist decodes each image once per zone size.
+ *
+ * Singleton, like MediaProbeService. Thread-safe: image() is called from
+ * QML's image loader threads.
+ */
+class ImageDecodeService : public QObject
+{
+    Q_OBJECT
+
+public:
+    static ImageDecodeService *instance();
+
+    /// Decode in the background so a later image() call returns at once.
+    void prefetch(const QString &filePath, const QSize &targetSize);
+
+    /// Decoded image, scaled to fit targetSize (invalid size = original).
+    /// Waits for a running prefetch or decodes on the calling thread.
+    QImage image(const QString &filePath, const QSize &targetSize);
+
+    /// image://zone/ URL for the provider
+    static QString providerUrl(const QString &filePath, const QSize &targetSize);
+    static bool    parseProviderId(const QString &id, QString &filePath, QSize &targetSize);
+
+private:
+    explicit ImageDecodeService(QObject *parent = nullptr);
+    ~ImageDecodeService() override;
+
+    static QString cacheKey(const QString &filePath, const QSize &targetSize);
+    static QImage  decode(const QString &filePath, const QSize &targetSize);
+    void           store(const QString &key, const QImage &image);
+
+    static ImageDecodeService *s_instance;
+
+    QThreadPool            m_pool;
+
+    QMutex                 m_mutex;
+    QWaitCondition         m_decoded;
+    QSet<QString>          m_pending;     // Keys being decoded by the pool
+};
+
+#endif // IMAGEDECODESERVICE_H
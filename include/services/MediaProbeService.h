@@ -0,0 +1,65 @@
+#ifndef MEDIAPROBESERVICE_H
+#define MEDIAPROBESERVICE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QSet>
+#include <QThreadPool>
+#include <QSharedPointer>
+
+#include "core/Models.h"
+#include "player/VlcRuntime.h"
+
+/**
+ * MediaProbeService - Background media metadata resolution.
+ *
+ * Parses video files on a small worker pool (resolution, codec, duration,
+ * frame rate) so ZonePlayer never waits on libVLC's parser from the Qt
+ * event loop. Results are kept in MediaCache and delivered via probeFinished.
+ * Files already present in MediaIndex with the same size/mtime are not
+ * re-parsed, and fresh results are written back to it.
+ *
+ * Singleton, like WindowService — all zones share one pool and cache.
+ */
+class MediaProbeService : public QObject
+{
+    Q_OBJECT
+
+public:
+    static MediaProbeService *instance();
+
+    /// Queue a probe. probeFinished is always emitted asynchronously,
+    /// even when the result is already cached.
+    Q_INVOKABLE void probe(const QString &filePath);
+    void probeAll(const QStringList &filePaths);
+
+    /// Cached result lookup (memory, then MediaIndex against the item's
+    /// listed size and mtime — no filesystem access, safe on the GUI thread).
+    /// Returns false if the file has not been probed yet.
+    bool cachedInfo(const nctv::MediaItem &item, nctv::MediaInfo &info);
+    bool isPending(const QString &filePath) const;
+
+signals:
+    void probeFinished(const QString &filePath, const nctv::MediaInfo &info);
+
+private:
+    explicit MediaProbeService(QObject *parent = nullptr);
+    ~MediaProbeService() override;
+
+    bool ensureVlc();
+    void onProbeResult(const QString &filePath, const nctv::MediaInfo &info);
+
+    // Runs on a pool thread
+    static nctv::MediaInfo probeFile(VlcRuntime *vlc, const QString &filePath);
+
+    static MediaProbeService *s_instance;
+
+    QSharedPointer<VlcRuntime> m_vlc;
+    QThreadPool                m_pool;
+
+    // Only touched on the Qt thread
+    QSet<QString>              m_pending;
+};
+
+#endif // MEDIAPROBESERVICE_H
@@ -4,7 +4,14 @@
 #include <QObject>
 #include <QString>
 #include <QStringList>
-#include <QMap>
+#include <QHash>
+#include <QTimer>
+#include <QFileSystemWatcher>
+#include <QThreadPool>
+#include <QElapsedTimer>
+
+#include "core/Models.h"
+#include "core/ZonePlaylistModel.h"
 
 /**
  * PlaylistService - Scans the local filesystem for media files per zone.
@@ -17,6 +24,32 @@
  *
  * Each folder can contain both "raw" and "optimized" (HEVC) media.
  * When an optimized version exists, it is preferred over the raw file.
+ * Zone-sized encodes ("<name>_optimized_448x849") are attached to the
+ * item as renditions; ZonePlayer picks one for its geometry.
+ *
+ * Files are classified by nctv::MediaTypes: by extension, and with
+ * content sniffing enabled by their header signature as well. A file
+ * listed by the zone's previous scan with the same size keeps its type,
+ * so a rescan only opens new or changed files.
+ *
+ * Each zone's list is a ZonePlaylistModel of MediaItems: type, size and
+ * optimized flag are determined during the scan, and probed metadata is
+ * filled in from MediaIndex there or merged in once MediaProbeService
+ * reports it. The QStringList properties remain for simple consumers.
+ *
+ * Scans run asynchronously: every zone is walked on its own pool thread
+ * and published (zonePlaylistChanged) as soon as it is ready.
+ *
+ * A snapshot of the resolved lists plus the mtime of every scanned folder
+ * is kept under dataPath. loadSnapshot() restores it for an instant cold
+ * start; the following scan only re-walks a zone when one of its folder
+ * mtimes differs (an entry was added, removed or renamed) or a listed
+ * file's size or mtime does (rewritten in place). Folder mtimes within
+ * the filesystem's timestamp resolution of the walk are not trusted.
+ *
+ * With startWatching(), the zone folders are watched (inotify via
+ * QFileSystemWatcher). Changes are debounced per zone and only that zone
+ * is rescanned; zonePlaylistChanged() fires when its list actually changed.
  */
 class PlaylistService : public QObject
 {
@@ -29,17 +62,33 @@ class PlaylistService : public QObject
     Q_PROPERTY(bool        isScanning       READ isScanning       NOTIFY isScanningChanged)
 
 public:
+    using MediaItems = QList<nctv::MediaItem>;
+
     explicit PlaylistService(QObject *parent = nullptr);
-    ~PlaylistService() override = default;
+    ~PlaylistService() override;
 
     // ── Configuration ──
     void setPlaylistRoot(const QString &root);
     void setOptimizedSuffix(const QString &suffix);
+    void setContentSniffing(bool enabled);
+    void setSnapshotPath(const QString &path);
+
+    // ── Snapshot (cold start) ──
+    bool loadSnapshot();
+    void saveSnapshot();
 
-    // ── Scanning ──
+    // ── Scanning (asynchronous; results arrive via zonePlaylistChanged) ──
     Q_INVOKABLE void scanAll();
     Q_INVOKABLE void scanZone(const QString &zoneName);
 
+    // ── Watching ──
+    void startWatching();
+    void stopWatching();
+
+    // ── Metadata ──
+    /// A file VideoOptimizer accepted as-is: mark it optimized in every zone.
+    void markAccepted(const QString &filePath, const nctv::MediaInfo &info);
+
     // ── Accessors ──
     QStringList backgroundFiles() const;
     QStringList mainFiles() const;
@@ -48,30 +97,63 @@ public:
     bool isScanning() const;
 
     Q_INVOKABLE QStringList filesForZone(const QString &zoneName) const;
+    Q_INVOKABLE ZonePlaylistModel *modelForZone(const QString &zoneName) const;
     Q_INVOKABLE int totalFileCount() const;
 
+    // ── Resolution (pure; also run by benchmarks/) ──
+    /// Pairs a directory listing's raw files with their optimized twins.
+    static MediaItems resolveOptimizedFiles(const MediaItems &rawFiles, const QString &optimizedSuffix);
+
 signals:
     void playlistsChanged();
     void isScanningChanged();
     void scanComplete(int totalFiles);
+    void zonePlaylistChanged(const QString &zoneName);
 
 private:
-    QStringList scanDirectory(const QString &dirPath) const;
-    bool isSupportedExtension(const QString &ext) const;
-    QStringList resolveOptimizedFiles(const QStringList &rawFiles) const;
+    using DirMtimes  = QHash<QString, qint64>;   // folder path → mtime (ms), -1 = too fresh
+
+    // Pool-thread safe (no member state)
+    static MediaItems scanDirectory(const QString &dirPath, bool sniffContent,
+                                    DirMtimes *dirMtimes = nullptr,
+                                    const MediaItems &knownItems = MediaItems());
+    static bool dirsUnchanged(const DirMtimes &dirMtimes);
+    static bool itemsUnchanged(const MediaItems &items);
+
+    void startZoneScan(const QString &zoneName);
+    void onZoneScanned(const QString &zoneName, quint64 generation,
+                       const MediaItems &items, const DirMtimes &dirMtimes);
+    void onProbeFinished(const QString &filePath, const nctv::MediaInfo &info);
+    QString zoneDirectory(const QString &zoneName) const;
+    void watchZone(const QString &zoneName);
+    void onDirectoryChanged(const QString &path);
+    void indexMedia(const MediaItems &items) const;
 
     QString m_playlistRoot;
     QString m_optimizedSuffix = "_optimized";
+    bool    m_sniffContent    = false;
     bool    m_isScanning      = false;
 
-    // Per-zone file lists
-    QStringList m_backgroundFiles;
-    QStringList m_mainFiles;
-    QStringList m_horizontalFiles;
-    QStringList m_verticalFiles;
+    // Per-zone playlists (owned)
+    QHash<QString, ZonePlaylistModel *> m_models;
+
+    // Asynchronous scanning
+    QThreadPool              m_scanPool;
+    QHash<QString, quint64>  m_zoneGenerations;   // Latest scan request per zone
+    int                      m_activeScans = 0;
+    QElapsedTimer            m_scanTimer;
+
+    // Snapshot of the last completed scan
+    QString                    m_snapshotPath;
+    QHash<QString, DirMtimes>  m_zoneDirMtimes;
+    bool                       m_snapshotDirty = false;
+
+    // Filesystem watching (one debounce timer per zone)
+    QFileSystemWatcher       m_watcher;
+    QHash<QString, QTimer *> m_debounceTimers;
+    bool                     m_watching = false;
 
-    // Supported media extensions
-    static const QStringList s_supportedExtensions;
+    static const QStringList s_zoneNames;
 };
 
 #endif // PLAYLISTSERVICE_H
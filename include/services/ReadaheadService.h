@@ -0,0 +1,62 @@
+#ifndef READAHEADSERVICE_H
+#define READAHEADSERVICE_H
+
+#include <QObject>
+#include <QString>
+#include <QSet>
+#include <QMutex>
+#include <QThreadPool>
+#include <QElapsedTimer>
+
+/**
+ * ReadaheadService - Warms the page cache for upcoming playlist items.
+ *
+ * SD cards and USB sticks cannot keep up with a decoder that has just
+ * opened a new file, so the first seconds of a video stutter on I/O.
+ * While the current item plays, ZonePlayer asks for the next one: the
+ * head of the file (or all of it, when small) is handed to the kernel
+ * with posix_fadvise(POSIX_FADV_WILLNEED) so it is read ahead of time.
+ *
+ * Requests are issued in chunks on one worker and paced to a shared
+ * budget (MB/s), so prefetching never competes with the streams that
+ * are playing right now. Linux only; a no-op elsewhere.
+ *
+ * Singleton, like ImageDecodeService — all zones share one budget.
+ */
+class ReadaheadService : public QObject
+{
+    Q_OBJECT
+
+public:
+    static ReadaheadService *instance();
+
+    /// budgetMBps <= 0 disables readahead. Files up to wholeFileMB are
+    /// read completely, larger ones only for their first headMB.
+    void setBudget(int budgetMBps, int headMB, int wholeFileMB);
+
+    void prefetch(const QString &filePath, qint64 fileSize);
+
+private:
+    explicit ReadaheadService(QObject *parent = nullptr);
+    ~ReadaheadService() override;
+
+    // Runs on the worker
+    void readahead(const QString &filePath, qint64 length);
+    void pace(qint64 bytes);
+
+    static ReadaheadService *s_instance;
+
+    QThreadPool     m_pool;
+
+    QMutex          m_mutex;
+    QSet<QString>   m_pending;
+    qint64          m_bytesPerSecond = 0;
+    qint64          m_headBytes      = 0;
+    qint64          m_wholeFileBytes = 0;
+
+    // Worker-only pacing state (the pool has a single thread)
+    QElapsedTimer   m_clock;
+    qint64          m_nextSlotNs     = 0;
+};
+
+#endif // READAHEADSERVICE_H
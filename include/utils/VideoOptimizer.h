@@ -6,13 +6,69 @@
 #include <QStringList>
 #include <QProcess>
 #include <QQueue>
+#include <QSet>
+#include <QHash>
+#include <QSize>
+#include <QTime>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QThreadPool>
+
+#include "core/Models.h"
 
 /**
  * VideoOptimizer - Background HandBrakeCLI wrapper for H.265 (HEVC) transcoding.
  *
- * On startup, scans the playlist directories for video files that haven't
- * been optimized yet. Queues them up and spawns HandBrakeCLI sequentially
- * via QProcess. The Splash screen stays visible until optimization finishes.
+ * Scans the playlist directories for video files that haven't been
+ * optimized yet (walked on a pool thread, like PlaylistService's scans:
+ * the stat and index lookup per file stay off the GUI thread), queues
+ * them and runs HandBrakeCLI on a small pool of
+ * QProcess workers. Playback does not wait for it: zones start with the
+ * raw files and PlaylistService switches to the optimized copy once it lands.
+ *
+ * Concurrency defaults to what the CPUs allow: the core count, capped by
+ * the service's cgroup CPU quota (systemd CPUQuota=), with ~4 encoder
+ * threads per job. Each job's x265 thread pool is limited to its share,
+ * so parallel jobs do not oversubscribe the machine. `progress` covers
+ * finished files plus the running encodes' reported percentage.
+ *
+ * To stay out of playback's way the encoder runs at the lowest CPU
+ * priority (nice) and, on Linux, in the idle I/O class. Output is written
+ * to a hidden temporary file and renamed into place when the encode
+ * succeeds, so scans never see a half-written "_optimized" file.
+ *
+ * Encoding competes with playback for the same CPUs (and, under
+ * systemd, the same CPUQuota). With a schedule (setSchedule), jobs run
+ * inside the off-peak windows, or outside them while playback headroom
+ * stays above a threshold. Headroom is sampled every few seconds as the
+ * share of the service's CPUs (cgroup quota, else the whole machine) not
+ * used by anything but the encoder. When it drops below the threshold the
+ * running encoders are frozen with SIGSTOP and continued with SIGCONT once
+ * it recovers (with some hysteresis); no new job starts in the meantime.
+ * An average can hide short bursts, so the encoder is also frozen for a
+ * while whenever the cgroup's quota throttled the service (cpu.stat
+ * nr_throttled), even inside a window. Sampling runs only during a run.
+ *
+ * Every job is recorded in a JSON journal under dataPath (pending,
+ * running, failed). After a restart, openJournal() deletes the leftovers
+ * of interrupted encodes and the next run retries those jobs first.
+ * HandBrake cannot continue a partial encode, so they start over. A job
+ * that keeps failing, or keeps taking the process down, is given up
+ * after three attempts until its input file changes.
+ *
+ * Files are judged by their probed stream (MediaProbeService): HEVC in
+ * Main or Main 10 profile, at most 4096×2160 @ 60 and within the bitrate
+ * cap already meets the target. Such files are accepted as-is: marked in
+ * MediaIndex (fileAccepted) so PlaylistService lists them as optimized,
+ * and never queued. Files not probed yet are probed before being judged.
+ *
+ * Encodes are sized to the zone whose folder holds the source
+ * (setZoneLayout): a file in playlist-vertical becomes a rendition of at
+ * most 448×849, "<name>_optimized_448x849", instead of a 1080p encode
+ * the zone only shows a fraction of. Full-screen zones keep the plain
+ * "<name>_optimized" name. 4K sources play as a fullscreen overlay, not
+ * in their zone: they are never boxed (full-frame encode, plain name) and
+ * 4K HEVC is accepted as-is. Other HEVC larger than its zone is re-encoded.
  *
  * Target: H.265 (HEVC) for native 4K hardware decoding on Raspberry Pi.
  */
@@ -34,6 +90,17 @@ public:
     void setPlaylistRoot(const QString &root);
     void setOptimizedSuffix(const QString &suffix);
     void setHandbrakePreset(const QString &preset);
+    void setNiceness(int niceness);
+    void setConcurrency(int jobs);      // 0 = derive from CPUs and quota
+    void setAcceptMaxBitrate(int kbps); // 0 = any bitrate
+    /// Zone geometry on a screen of the given size; sizes the renditions.
+    void setZoneLayout(const QList<nctv::ZoneDefinition> &zones, const QSize &screen);
+    /// "HH:mm-HH:mm" windows (may wrap midnight) and the playback headroom
+    /// needed outside them. Neither set = run whenever there is work.
+    void setSchedule(const QStringList &offPeakWindows, int minHeadroomPercent);
+
+    /// Load the job journal and clean up after interrupted encodes.
+    bool openJournal(const QString &filePath);
 
     // ── Control ──
     Q_INVOKABLE void startOptimization();
@@ -52,41 +119,131 @@ signals:
     void progressChanged();
     void optimizationFinished();
     void fileOptimized(const QString &inputPath, const QString &outputPath);
+    void fileAccepted(const QString &filePath, const nctv::MediaInfo &info);
     void errorOccurred(const QString &message);
 
 private slots:
-    void onProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
-    void onProcessError(QProcess::ProcessError error);
-    void onProcessOutput();
+    void onProbeFinished(const QString &filePath, const nctv::MediaInfo &info);
 
 private:
     struct OptimizeJob {
         QString inputPath;
         QString outputPath;
+        QString tempPath;       // Hidden; renamed to outputPath on success
+        QSize   box;            // Zone rendition size; invalid = preset frame size
+    };
+
+    // One HandBrakeCLI slot; the process is reused from job to job
+    struct Worker {
+        QProcess   *process  = nullptr;
+        OptimizeJob job;                // Empty inputPath = idle
+        double      fraction = 0.0;     // Reported progress of the running job
     };
 
+    // Journal record per input file; finished jobs are removed
+    enum class JobState { Pending, Running, Failed };
+    struct JournalEntry {
+        JobState state        = JobState::Pending;
+        int      attempts     = 0;
+        qint64   inputSize    = 0;
+        qint64   inputMtimeMs = 0;
+        QString  outputPath;    // Where the encode lands (name depends on the probed source)
+    };
+
+    void setJobState(const QString &inputPath, JobState state);
+    bool isGivenUp(const QString &inputPath) const;
+    bool isGivenUp(const QString &inputPath, qint64 size, qint64 mtimeMs) const;
+    void saveJournal() const;
+
+    // Off-peak / headroom scheduling
+    struct TimeWindow {
+        QTime start;
+        QTime end;
+    };
+    bool   hasSchedule() const;
+    void   setOptimizing(bool optimizing);
+    void   startSchedule();
+    void   updateSchedule();
+    double sampleHeadroom();
+    bool   inOffPeakWindow(const QTime &time) const;
+    void   setPaused(bool paused, const QString &reason);
+
+    // One video found by the candidate walk, with what the walker learned
+    struct Candidate {
+        QString         inputPath;
+        qint64          size    = 0;
+        qint64          mtimeMs = 0;
+        nctv::MediaInfo info;                   // Invalid = not indexed yet
+        bool            outputExists = false;   // Only known with info
+    };
+    using Candidates = QList<Candidate>;
+
     void scanForUnoptimizedFiles();
+    void onCandidatesScanned(const Candidates &candidates);
+    // Pool-thread safe (no member state)
+    static Candidates findCandidates(const QString &playlistRoot, const QString &suffix,
+                                     const QHash<QString, QSize> &boxes);
+    void enqueueJob(const QString &inputPath, const nctv::MediaInfo &info);
+    void ensureWorkers();
+    QProcess *createProcess(Worker *worker);
     void processNextJob();
-    bool isVideoFile(const QString &ext) const;
-    bool isAlreadyHevc(const QString &filePath) const;
-    QString buildOutputPath(const QString &inputPath) const;
+    void startJob(Worker *worker, const OptimizeJob &job);
+    void finishJob(Worker *worker, bool success);
+    void onProcessFinished(Worker *worker, int exitCode, QProcess::ExitStatus exitStatus);
+    void onProcessError(Worker *worker, QProcess::ProcessError error);
+    void onProcessOutput(Worker *worker);
+    void updateStatus();
+    int  activeJobs() const;
+    static double availableCpus();
+    bool meetsTarget(const QString &filePath, const nctv::MediaInfo &info) const;
+    QSize renditionBox(const QString &inputPath, const nctv::MediaInfo &info) const;
+    void acceptAsIs(const QString &filePath, nctv::MediaInfo info);
+    QString buildOutputPath(const QString &inputPath, const nctv::MediaInfo &info) const;
+    static QSize renditionBox(const QHash<QString, QSize> &boxes, const QString &inputPath,
+                              const nctv::MediaInfo &info);
+    static QString buildOutputPath(const QString &inputPath, const QString &suffix, const QSize &box);
+    static QString buildTempPath(const QString &outputPath);
     bool findHandbrake();
 
     QString     m_playlistRoot;
     QString     m_optimizedSuffix = "_optimized";
     QString     m_handbrakePreset = "H.265 MKV 1080p30"; // Default HandBrake preset
     QString     m_handbrakePath;
-
-    QProcess   *m_process         = nullptr;
+    int         m_niceness        = 19;
+    int         m_concurrency     = 0;       // Configured (0 = auto)
+    int         m_threadsPerJob   = 0;       // x265 pool size per job (0 = encoder default)
+    qint64      m_acceptMaxBitrate = 20000000; // bits/s; HEVC above this is re-encoded
+    QHash<QString, QSize> m_renditionBoxes;    // Folder name → box (none = full frame)
+
+    QList<TimeWindow> m_offPeakWindows;
+    int         m_minHeadroom     = 0;       // Percent; 0 = only the windows decide
+    QTimer      m_scheduleTimer;
+    bool        m_paused          = false;
+    QString     m_pauseReason;
+    QElapsedTimer m_sampleClock;
+    qint64      m_lastBusyUs      = -1;      // Service (or machine) CPU time
+    qint64      m_lastNrThrottled = -1;      // cgroup cpu.stat counters
+    qint64      m_lastThrottledUs = -1;
+    QElapsedTimer m_throttleClock;           // Since the quota last throttled the service
+    QHash<qint64, qint64> m_lastEncoderUs;   // HandBrake pid → CPU time
+
+    QList<Worker *> m_workers;
     bool        m_isOptimizing    = false;
     bool        m_cancelled       = false;
+    bool        m_rescanRequested = false;
+    bool        m_scanning        = false;   // Candidate walk in flight
+    QThreadPool m_scanPool;
     QString     m_statusMessage   = "Initializing...";
 
     QQueue<OptimizeJob> m_jobQueue;
+    QSet<QString> m_awaitingProbe;   // Candidates whose codec is not known yet
+    QSet<QString> m_queued;          // Inputs in m_jobQueue or running
+
+    QString     m_journalPath;
+    QHash<QString, JournalEntry> m_journal;   // inputPath → entry
     int         m_totalFiles      = 0;
     int         m_completedFiles  = 0;
 
-    static const QStringList s_videoExtensions;
 };
 
 #endif // VIDEOOPTIMIZER_H
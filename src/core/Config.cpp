@@ -17,11 +17,13 @@ Config::Config(QObject *parent)
 #ifdef NCTV_PLATFORM_PI
     m_playlistRoot = QStringLiteral("/var/lib/nctv-player/playlist");
     m_logPath      = QStringLiteral("/var/log/nctv-player.log");
+    m_dataPath     = QStringLiteral("/var/lib/nctv-player/data");
 #else
     // Desktop development defaults
     m_playlistRoot = QCoreApplication::applicationDirPath() + QStringLiteral("/../playlist");
     m_logPath      = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
                      + QStringLiteral("/nctv-player.log");
+    m_dataPath     = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
 #endif
 }
 
@@ -75,23 +77,61 @@ void Config::load()
     m_retryIntervalMs = settings.value("retryIntervalMs", m_retryIntervalMs).toInt();
     m_imageDurationMs = settings.value("imageDurationMs", m_imageDurationMs).toInt();
     m_audioEnabled    = settings.value("audioEnabled", m_audioEnabled).toBool();
+    m_watchPlaylists  = settings.value("watchPlaylists", m_watchPlaylists).toBool();
+    m_sniffMediaTypes = settings.value("sniffMediaTypes", m_sniffMediaTypes).toBool();
     settings.endGroup();
 
     // [Paths]
     settings.beginGroup(QStringLiteral("Paths"));
     m_playlistRoot = settings.value("playlistRoot", m_playlistRoot).toString();
     m_logPath      = settings.value("logPath", m_logPath).toString();
+    m_dataPath     = settings.value("dataPath", m_dataPath).toString();
     settings.endGroup();
 
     // [Display]
     settings.beginGroup(QStringLiteral("Display"));
     m_targetWidth  = settings.value("targetWidth", m_targetWidth).toInt();
     m_targetHeight = settings.value("targetHeight", m_targetHeight).toInt();
+    m_renderMode   = settings.value("renderMode", m_renderMode).toString().toLower();
     settings.endGroup();
 
     // [Optimization]
     settings.beginGroup(QStringLiteral("Optimization"));
     m_optimizedSuffix = settings.value("optimizedSuffix", m_optimizedSuffix).toString();
+    m_optimizerEnabled  = settings.value("enabled", m_optimizerEnabled).toBool();
+    m_optimizerNiceness = settings.value("niceness", m_optimizerNiceness).toInt();
+    m_optimizerJobs     = settings.value("jobs", m_optimizerJobs).toInt();
+    m_acceptMaxBitrateKbps = settings.value("acceptMaxBitrateKbps", m_acceptMaxBitrateKbps).toInt();
+    m_offPeakWindows     = settings.value("offPeakWindows", m_offPeakWindows).toStringList();
+    m_minHeadroomPercent = settings.value("minHeadroomPercent", m_minHeadroomPercent).toInt();
+    settings.endGroup();
+
+    // [Playback]
+    settings.beginGroup(QStringLiteral("Playback"));
+    m_prerollEnabled       = settings.value("prerollEnabled", m_prerollEnabled).toBool();
+    m_quarantineAfterFailures = settings.value("quarantineAfterFailures", m_quarantineAfterFailures).toInt();
+    m_occlusionPolicy      = settings.value("occlusionPolicy", m_occlusionPolicy).toString();
+    m_readaheadBudgetMBps  = settings.value("readaheadBudgetMBps", m_readaheadBudgetMBps).toInt();
+    m_readaheadHeadMB      = settings.value("readaheadHeadMB", m_readaheadHeadMB).toInt();
+    m_readaheadWholeFileMB = settings.value("readaheadWholeFileMB", m_readaheadWholeFileMB).toInt();
+    settings.endGroup();
+
+    // [Decode]
+    settings.beginGroup(QStringLiteral("Decode"));
+    m_decodeCapacity        = settings.value("capacity", m_decodeCapacity).toDouble();
+    m_decodeSoftwareMaxCost = settings.value("softwareMaxCost", m_decodeSoftwareMaxCost).toDouble();
+    settings.endGroup();
+
+    // [Cache]
+    settings.beginGroup(QStringLiteral("Cache"));
+    m_cacheBudgetMB = settings.value("budgetMB", m_cacheBudgetMB).toInt();
+    settings.endGroup();
+
+    // [VlcOptions] — one comma-separated list per zone name
+    settings.beginGroup(QStringLiteral("VlcOptions"));
+    m_vlcOptions.clear();
+    for (const QString &zone : settings.childKeys())
+        m_vlcOptions.insert(zone, settings.value(zone).toStringList());
     settings.endGroup();
 
     qInfo() << "[Config] Loaded:"
@@ -118,10 +158,34 @@ int     Config::retryIntervalMs() const { return m_retryIntervalMs; }
 int     Config::imageDurationMs() const { return m_imageDurationMs; }
 QString Config::playlistRoot() const    { return m_playlistRoot; }
 QString Config::logPath() const         { return m_logPath; }
+QString Config::dataPath() const        { return m_dataPath; }
 int     Config::targetWidth() const     { return m_targetWidth; }
 int     Config::targetHeight() const    { return m_targetHeight; }
+QString Config::renderMode() const      { return m_renderMode; }
 bool    Config::audioEnabled() const    { return m_audioEnabled; }
+bool    Config::watchPlaylists() const  { return m_watchPlaylists; }
+bool    Config::sniffMediaTypes() const { return m_sniffMediaTypes; }
 QString Config::optimizedSuffix() const { return m_optimizedSuffix; }
+bool    Config::optimizerEnabled() const  { return m_optimizerEnabled; }
+int     Config::optimizerNiceness() const { return m_optimizerNiceness; }
+int     Config::optimizerJobs() const     { return m_optimizerJobs; }
+int     Config::acceptMaxBitrateKbps() const { return m_acceptMaxBitrateKbps; }
+QStringList Config::offPeakWindows() const  { return m_offPeakWindows; }
+int     Config::minHeadroomPercent() const  { return m_minHeadroomPercent; }
+bool    Config::prerollEnabled() const  { return m_prerollEnabled; }
+int     Config::quarantineAfterFailures() const { return m_quarantineAfterFailures; }
+QString Config::occlusionPolicy() const { return m_occlusionPolicy; }
+int     Config::readaheadBudgetMBps() const  { return m_readaheadBudgetMBps; }
+int     Config::readaheadHeadMB() const      { return m_readaheadHeadMB; }
+int     Config::readaheadWholeFileMB() const { return m_readaheadWholeFileMB; }
+double  Config::decodeCapacity() const        { return m_decodeCapacity; }
+double  Config::decodeSoftwareMaxCost() const { return m_decodeSoftwareMaxCost; }
+int     Config::cacheBudgetMB() const   { return m_cacheBudgetMB; }
+
+QStringList Config::vlcOptions(const QString &zoneName) const
+{
+    return m_vlcOptions.value(zoneName);
+}
 
 QVariantMap Config::toMap() const
 {
@@ -131,9 +195,28 @@ QVariantMap Config::toMap() const
         {"imageDurationMs", m_imageDurationMs},
         {"playlistRoot",    m_playlistRoot},
         {"logPath",         m_logPath},
+        {"dataPath",        m_dataPath},
         {"targetWidth",     m_targetWidth},
         {"targetHeight",    m_targetHeight},
+        {"renderMode",      m_renderMode},
         {"audioEnabled",    m_audioEnabled},
+        {"watchPlaylists",  m_watchPlaylists},
+        {"sniffMediaTypes", m_sniffMediaTypes},
         {"optimizedSuffix", m_optimizedSuffix},
+        {"optimizerEnabled",  m_optimizerEnabled},
+        {"optimizerNiceness", m_optimizerNiceness},
+        {"optimizerJobs",     m_optimizerJobs},
+        {"acceptMaxBitrateKbps", m_acceptMaxBitrateKbps},
+        {"offPeakWindows",       m_offPeakWindows},
+        {"minHeadroomPercent",   m_minHeadroomPercent},
+        {"prerollEnabled",  m_prerollEnabled},
+        {"quarantineAfterFailures", m_quarantineAfterFailures},
+        {"occlusionPolicy", m_occlusionPolicy},
+        {"readaheadBudgetMBps",  m_readaheadBudgetMBps},
+        {"readaheadHeadMB",      m_readaheadHeadMB},
+        {"readaheadWholeFileMB", m_readaheadWholeFileMB},
+        {"decodeCapacity",        m_decodeCapacity},
+        {"decodeSoftwareMaxCost", m_decodeSoftwareMaxCost},
+        {"cacheBudgetMB",   m_cacheBudgetMB},
     };
 }
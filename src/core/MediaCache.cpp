@@ -0,0 +1,298 @@
+#include "core/MediaCache.h"
+
+#include <QGuiApplication>
+#include <QFile>
+#include <QMutexLocker>
+#include <QDebug>
+
+MediaCache *MediaCache::s_instance = nullptr;
+
+static constexpr qint64 kMegabyte            = 1024 * 1024;
+static constexpr qint64 kFallbackBudget      = 64 * kMegabyte;
+static constexpr int    kPressureIntervalMs  = 5000;
+static constexpr double kPressureThreshold   = 0.85;   // of memory.max
+
+// ──────────────────────────────────────────────
+// cgroup v2 Helpers (systemd MemoryMax=)
+// ──────────────────────────────────────────────
+namespace {
+
+// "0::/system.slice/nctv-player.service" → /sys/fs/cgroup/system.slice/nctv-player.service
+QString cgroupDir()
+{
+    QFile file(QStringLiteral("/proc/self/cgroup"));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return QString();
+
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine().trimmed();
+        if (line.startsWith("0::"))
+            return QStringLiteral("/sys/fs/cgroup") + QString::fromUtf8(line.mid(3));
+    }
+    return QString();
+}
+
+// Bytes, or -1 when the file is missing or reads "max"
+qint64 readCgroupBytes(const QString &name)
+{
+    static const QString dir = cgroupDir();
+    if (dir.isEmpty())
+        return -1;
+
+    QFile file(dir + QLatin1Char('/') + name);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return -1;
+
+    bool ok = false;
+    const qint64 value = file.readAll().trimmed().toLongLong(&ok);
+    return ok ? value : -1;
+}
+
+// One "<key> <bytes>" line of memory.stat, -1 if missing
+qint64 readMemoryStat(const char *key)
+{
+    static const QString dir = cgroupDir();
+    if (dir.isEmpty())
+        return -1;
+
+    QFile file(dir + QStringLiteral("/memory.stat"));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return -1;
+
+    while (!file.atEnd()) {
+        const QList<QByteArray> fields = file.readLine().simplified().split(' ');
+        if (fields.size() == 2 && fields.at(0) == key)
+            return fields.at(1).toLongLong();
+    }
+    return -1;
+}
+
+} // namespace
+
+// ──────────────────────────────────────────────
+// Constructor / Singleton
+// ──────────────────────────────────────────────
+MediaCache::MediaCache(QObject *parent)
+    : QObject(parent)
+{
+    m_entries.setMaxCost(defaultBudgetBytes());
+
+    // No pressure polling without a cgroup limit to compare against
+    if (readCgroupBytes(QStringLiteral("memory.max")) > 0) {
+        m_pressureTimer.setInterval(kPressureIntervalMs);
+        connect(&m_pressureTimer, &QTimer::timeout, this, &MediaCache::checkMemoryPressure);
+        m_pressureTimer.start();
+    }
+}
+
+MediaCache *MediaCache::instance()
+{
+    if (!s_instance) {
+        s_instance = new MediaCache(qApp);
+    }
+    return s_instance;
+}
+
+qint64 MediaCache::defaultBudgetBytes()
+{
+    // One eighth of the service limit (512M → 64 MB), within sane bounds
+    const qint64 memoryMax = readCgroupBytes(QStringLiteral("memory.max"));
+    if (memoryMax <= 0)
+        return kFallbackBudget;
+    return qBound(16 * kMegabyte, memoryMax / 8, 256 * kMegabyte);
+}
+
+// ──────────────────────────────────────────────
+// Budget
+// ──────────────────────────────────────────────
+void MediaCache::setBudgetMB(int megabytes)
+{
+    const qint64 budget = megabytes > 0 ? megabytes * kMegabyte : defaultBudgetBytes();
+    {
+        QMutexLocker locker(&m_mutex);
+        m_entries.setMaxCost(budget);
+    }
+    qInfo() << "[MediaCache] Budget:" << budget / kMegabyte << "MB"
+            << (megabytes > 0 ? "(config)" : "(derived)");
+    emit statsChanged();
+}
+
+qint64 MediaCache::budgetBytes() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_entries.maxCost();
+}
+
+qint64 MediaCache::usedBytes() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_entries.totalCost();
+}
+
+// ──────────────────────────────────────────────
+// Lookup / Insert
+// ──────────────────────────────────────────────
+bool MediaCache::lookup(const QString &key, Entry &entry)
+{
+    bool found = false;
+    {
+        QMutexLocker locker(&m_mutex);
+
+        // object() also marks the entry most recently used
+        const Entry *cached = m_entries.object(key);
+        if (cached) {
+            ++m_hits;
+            entry = *cached;
+            found = true;
+        } else {
+            ++m_misses;
+        }
+    }
+    notifyStatsChanged();
+    return found;
+}
+
+void MediaCache::insert(const QString &key, Entry *entry, qint64 cost)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        // QCache takes ownership (and deletes entries larger than the budget)
+        m_entries.insert(key, entry, cost);
+    }
+    notifyStatsChanged();
+}
+
+void MediaCache::notifyStatsChanged()
+{
+    // Lookups and inserts come from decode and probe workers: coalesced
+    // into one queued emit on the Qt thread, with or without pressure polling
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_statsPending)
+            return;
+        m_statsPending = true;
+    }
+    QMetaObject::invokeMethod(this, [this]() {
+        {
+            QMutexLocker locker(&m_mutex);
+            m_statsPending = false;
+        }
+        emit statsChanged();
+    }, Qt::QueuedConnection);
+}
+
+bool MediaCache::contains(const QString &key) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_entries.contains(key);
+}
+
+bool MediaCache::lookupImage(const QString &key, QImage &image)
+{
+    Entry entry;
+    if (!lookup(QStringLiteral("img:") + key, entry))
+        return false;
+    image = entry.image;
+    return true;
+}
+
+bool MediaCache::containsImage(const QString &key) const
+{
+    return contains(QStringLiteral("img:") + key);
+}
+
+void MediaCache::insertImage(const QString &key, const QImage &image)
+{
+    if (image.isNull())
+        return;
+    insert(QStringLiteral("img:") + key, new Entry{image, {}}, image.sizeInBytes());
+}
+
+bool MediaCache::lookupMediaInfo(const QString &filePath, nctv::MediaInfo &info)
+{
+    Entry entry;
+    if (!lookup(QStringLiteral("info:") + filePath, entry))
+        return false;
+    info = entry.info;
+    return true;
+}
+
+bool MediaCache::containsMediaInfo(const QString &filePath) const
+{
+    return contains(QStringLiteral("info:") + filePath);
+}
+
+void MediaCache::insertMediaInfo(const QString &filePath, const nctv::MediaInfo &info)
+{
+    const qint64 cost = qint64(sizeof(Entry)) + (filePath.size() + info.codec.size()) * 2;
+    insert(QStringLiteral("info:") + filePath, new Entry{QImage(), info}, cost);
+}
+
+// ──────────────────────────────────────────────
+// Eviction
+// ──────────────────────────────────────────────
+void MediaCache::trim(double keepFraction)
+{
+    qint64 before = 0;
+    qint64 after  = 0;
+    {
+        QMutexLocker locker(&m_mutex);
+        before = m_entries.totalCost();
+
+        // Shrinking maxCost evicts from the LRU end; restore it afterwards
+        const qint64 budget = m_entries.maxCost();
+        m_entries.setMaxCost(qint64(before * qBound(0.0, keepFraction, 1.0)));
+        m_entries.setMaxCost(budget);
+        after = m_entries.totalCost();
+    }
+
+    qInfo() << "[MediaCache] Trimmed" << (before - after) / 1024 << "KB,"
+            << after / 1024 << "KB kept";
+    emit statsChanged();
+}
+
+void MediaCache::checkMemoryPressure()
+{
+    // memory.current includes the page cache, which the kernel reclaims on
+    // its own (playlist reads and readahead fill it to the limit): only
+    // what cannot be dropped counts
+    const qint64 current = readCgroupBytes(QStringLiteral("memory.current"));
+    const qint64 file    = readMemoryStat("file");
+    const qint64 limit   = readCgroupBytes(QStringLiteral("memory.max"));
+    const qint64 used    = current > 0 && file >= 0 ? current - file : -1;
+
+    if (used > 0 && limit > 0 && used > qint64(limit * kPressureThreshold)) {
+        qWarning() << "[MediaCache] Memory pressure:" << used / kMegabyte << "of"
+                   << limit / kMegabyte << "MB in use (page cache excluded), shrinking cache";
+        trim(0.5);
+        return;
+    }
+    emit statsChanged();
+}
+
+// ──────────────────────────────────────────────
+// Statistics
+// ──────────────────────────────────────────────
+quint64 MediaCache::hits() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_hits;
+}
+
+quint64 MediaCache::misses() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_misses;
+}
+
+QVariantMap MediaCache::stats() const
+{
+    QMutexLocker locker(&m_mutex);
+    return {
+        {"hits",        m_hits},
+        {"misses",      m_misses},
+        {"entries",     m_entries.count()},
+        {"usedBytes",   m_entries.totalCost()},
+        {"budgetBytes", m_entries.maxCost()},
+    };
+}
@@ -0,0 +1,411 @@
+#include "core/MediaIndex.h"
+
+#include <QGuiApplication>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDir>
+#include <QMutexLocker>
+#include <QDebug>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+MediaIndex *MediaIndex::s_instance = nullptr;
+
+// ──────────────────────────────────────────────
+// On-disk Format
+// ──────────────────────────────────────────────
+namespace {
+
+constexpr quint32 kMagic   = 0x494D434E; // "NCMI"
+constexpr quint32 kVersion = 2;   // 2: profile, bitrate, accepted-as-optimized
+
+enum RecordFlags : quint32 {
+    FlagValid     = 1u << 0,
+    FlagIs4K      = 1u << 1,
+    FlagOptimized = 1u << 2,     // Accepted as-is by VideoOptimizer
+};
+
+struct Header {
+    quint32 magic;
+    quint32 version;
+    quint32 recordCount;
+    quint32 stringBytes;
+};
+
+struct Record {
+    quint64 pathHash;
+    qint64  fileSize;
+    qint64  mtimeMs;
+    qint64  durationMs;
+    quint32 width;
+    quint32 height;
+    char    codec[4];
+    quint32 frameRateMilli;   // fps × 1000
+    quint32 flags;
+    quint32 pathOffset;
+    quint32 pathLength;
+    quint32 bitrateKbps;
+    qint32  profile;
+    quint32 reserved;
+};
+
+static_assert(sizeof(Header) == 16, "MediaIndex header layout changed");
+static_assert(sizeof(Record) == 72, "MediaIndex record layout changed");
+
+// Stable across runs (unlike qHash, which is seeded per process)
+quint64 fnv1a(const QByteArray &bytes)
+{
+    quint64 hash = 14695981039346656037ull;
+    for (const char c : bytes) {
+        hash ^= static_cast<quint8>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+void decodeRecord(const Record &r, qint64 &fileSize, qint64 &mtimeMs, nctv::MediaInfo &info)
+{
+    fileSize        = r.fileSize;
+    mtimeMs         = r.mtimeMs;
+    info.width      = r.width;
+    info.height     = r.height;
+    info.codec      = QString::fromLatin1(r.codec, 4).trimmed();
+    info.profile    = r.profile;
+    info.bitrate    = qint64(r.bitrateKbps) * 1000;
+    info.durationMs = r.durationMs;
+    info.frameRate  = r.frameRateMilli / 1000.0;
+    info.valid      = (r.flags & FlagValid) != 0;
+    info.acceptedOptimized = (r.flags & FlagOptimized) != 0;
+}
+
+} // namespace
+
+// ──────────────────────────────────────────────
+// Constructor / Destructor
+// ──────────────────────────────────────────────
+MediaIndex::MediaIndex(QObject *parent)
+    : QObject(parent)
+{
+    // Batch bursts of probe results into a single rewrite
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(2000);
+    connect(&m_saveTimer, &QTimer::timeout, this, &MediaIndex::save);
+
+    m_savePool.setMaxThreadCount(1);
+}
+
+MediaIndex::~MediaIndex()
+{
+    // Finish a write in flight, then flush what arrived since
+    m_savePool.waitForDone();
+    save();
+    m_savePool.waitForDone();
+    unmap();
+}
+
+MediaIndex *MediaIndex::instance()
+{
+    if (!s_instance) {
+        s_instance = new MediaIndex(qApp);
+    }
+    return s_instance;
+}
+
+// ──────────────────────────────────────────────
+// Open / Map
+// ──────────────────────────────────────────────
+bool MediaIndex::open(const QString &filePath)
+{
+    QMutexLocker locker(&m_mutex);
+
+    unmap();
+    m_filePath = filePath;
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+    m_file.setFileName(filePath);
+    if (!m_file.exists()) {
+        qInfo() << "[MediaIndex] No index yet, starting empty:" << filePath;
+        return true;
+    }
+
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qWarning() << "[MediaIndex] Cannot open index:" << filePath << m_file.errorString();
+        return false;
+    }
+
+    const qint64 size = m_file.size();
+    const uchar *map = size >= qint64(sizeof(Header)) ? m_file.map(0, size) : nullptr;
+    if (!map) {
+        qWarning() << "[MediaIndex] Cannot map index, starting empty:" << filePath;
+        m_file.close();
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, map, sizeof(Header));
+
+    const qint64 expected = qint64(sizeof(Header))
+                          + qint64(header.recordCount) * qint64(sizeof(Record))
+                          + qint64(header.stringBytes);
+    if (header.magic != kMagic || header.version != kVersion || expected != size) {
+        qWarning() << "[MediaIndex] Incompatible or truncated index, rebuilding:" << filePath;
+        m_file.unmap(const_cast<uchar *>(map));
+        m_file.close();
+        return false;
+    }
+
+    // Lookups read paths straight out of the string table: every record
+    // must point inside it, or the whole file is rebuilt
+    const auto *records = reinterpret_cast<const Record *>(map + sizeof(Header));
+    for (quint32 i = 0; i < header.recordCount; ++i) {
+        if (quint64(records[i].pathOffset) + records[i].pathLength > header.stringBytes) {
+            qWarning() << "[MediaIndex] Corrupt index (record" << i << "path out of range), rebuilding:"
+                       << filePath;
+            m_file.unmap(const_cast<uchar *>(map));
+            m_file.close();
+            return false;
+        }
+    }
+
+    m_map         = map;
+    m_mapSize     = size;
+    m_recordCount = header.recordCount;
+
+    qInfo() << "[MediaIndex] Mapped" << m_recordCount << "entries from" << filePath;
+    return true;
+}
+
+void MediaIndex::unmap()
+{
+    if (m_map) {
+        m_file.unmap(const_cast<uchar *>(m_map));
+        m_map = nullptr;
+    }
+    m_mapSize = 0;
+    m_recordCount = 0;
+    if (m_file.isOpen())
+        m_file.close();
+}
+
+// ──────────────────────────────────────────────
+// Lookup
+// ──────────────────────────────────────────────
+bool MediaIndex::findMapped(const QString &filePath, Entry &entry) const
+{
+    if (!m_map || m_recordCount == 0)
+        return false;
+
+    const QByteArray pathUtf8 = filePath.toUtf8();
+    const quint64 hash = fnv1a(pathUtf8);
+
+    const auto *records = reinterpret_cast<const Record *>(m_map + sizeof(Header));
+    const auto *strings = reinterpret_cast<const char *>(records + m_recordCount);
+    const Record *end = records + m_recordCount;
+
+    const Record *it = std::lower_bound(records, end, hash,
+        [](const Record &r, quint64 h) { return r.pathHash < h; });
+
+    for (; it != end && it->pathHash == hash; ++it) {
+        if (it->pathLength != quint32(pathUtf8.size())
+            || std::memcmp(strings + it->pathOffset, pathUtf8.constData(), it->pathLength) != 0) {
+            continue;
+        }
+
+        decodeRecord(*it, entry.fileSize, entry.mtimeMs, entry.info);
+        return true;
+    }
+    return false;
+}
+
+bool MediaIndex::lookup(const QString &filePath, qint64 fileSize, qint64 mtimeMs,
+                        nctv::MediaInfo &info) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    Entry entry;
+    const auto it = m_overlay.constFind(filePath);
+    if (it != m_overlay.constEnd()) {
+        entry = it.value();
+    } else if (!findMapped(filePath, entry)) {
+        return false;
+    }
+
+    // Stale entry: the file was replaced since it was probed
+    if (entry.fileSize != fileSize || entry.mtimeMs != mtimeMs)
+        return false;
+
+    info = entry.info;
+    return true;
+}
+
+bool MediaIndex::lookup(const QString &filePath, nctv::MediaInfo &info) const
+{
+    const QFileInfo fi(filePath);
+    if (!fi.exists())
+        return false;
+    return lookup(filePath, fi.size(), fi.lastModified().toMSecsSinceEpoch(), info);
+}
+
+void MediaIndex::insert(const QString &filePath, qint64 fileSize, qint64 mtimeMs,
+                        const nctv::MediaInfo &info)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_overlay.insert(filePath, Entry{fileSize, mtimeMs, info});
+    }
+
+    // Inserts come from probe workers; the timer lives on the Qt thread
+    QMetaObject::invokeMethod(this, [this]() { m_saveTimer.start(); }, Qt::QueuedConnection);
+}
+
+int MediaIndex::entryCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return int(m_recordCount) + m_overlay.size();
+}
+
+// ──────────────────────────────────────────────
+// Save
+// ──────────────────────────────────────────────
+void MediaIndex::save()
+{
+    struct Pending {
+        quint64    hash;
+        QByteArray path;
+        Entry      entry;
+    };
+    std::vector<Pending>  all;
+    QHash<QString, Entry> written;
+    QString               filePath;
+
+    // Only a copy is taken under the lock: probe workers keep looking up
+    // while the worker stats and writes
+    {
+        QMutexLocker locker(&m_mutex);
+
+        if (m_overlay.isEmpty() || m_filePath.isEmpty() || m_saving)
+            return;
+        m_saving = true;
+
+        all.reserve(m_recordCount + m_overlay.size());
+
+        // Carry over mapped records that were not superseded
+        if (m_map) {
+            const auto *records = reinterpret_cast<const Record *>(m_map + sizeof(Header));
+            const auto *strings = reinterpret_cast<const char *>(records + m_recordCount);
+            for (quint32 i = 0; i < m_recordCount; ++i) {
+                const Record &r = records[i];
+                const QByteArray path(strings + r.pathOffset, int(r.pathLength));
+                if (m_overlay.contains(QString::fromUtf8(path)))
+                    continue;
+
+                Entry entry;
+                decodeRecord(r, entry.fileSize, entry.mtimeMs, entry.info);
+                all.push_back({r.pathHash, path, entry});
+            }
+        }
+
+        for (auto it = m_overlay.constBegin(); it != m_overlay.constEnd(); ++it) {
+            const QByteArray path = it.key().toUtf8();
+            all.push_back({fnv1a(path), path, it.value()});
+        }
+
+        written  = m_overlay;
+        filePath = m_filePath;
+    }
+
+    m_savePool.start([this, all = std::move(all), written, filePath]() mutable {
+        // Files deleted since they were probed are dropped, so the index
+        // does not only grow
+        const auto deleted = std::remove_if(all.begin(), all.end(), [](const Pending &p) {
+            return !QFileInfo::exists(QString::fromUtf8(p.path));
+        });
+        const int pruned = int(std::distance(deleted, all.end()));
+        all.erase(deleted, all.end());
+
+        std::sort(all.begin(), all.end(),
+                  [](const Pending &a, const Pending &b) { return a.hash < b.hash; });
+
+        QByteArray records;
+        QByteArray strings;
+        records.reserve(int(all.size() * sizeof(Record)));
+
+        for (const Pending &p : all) {
+            Record r{};
+            r.pathHash       = p.hash;
+            r.fileSize       = p.entry.fileSize;
+            r.mtimeMs        = p.entry.mtimeMs;
+            r.durationMs     = p.entry.info.durationMs;
+            r.width          = p.entry.info.width;
+            r.height         = p.entry.info.height;
+            r.frameRateMilli = quint32(p.entry.info.frameRate * 1000.0 + 0.5);
+            r.bitrateKbps    = quint32(qBound<qint64>(0, p.entry.info.bitrate / 1000,
+                                                      std::numeric_limits<quint32>::max()));
+            r.profile        = p.entry.info.profile;
+            r.flags          = (p.entry.info.valid ? FlagValid : 0u)
+                             | (p.entry.info.is4K() ? FlagIs4K : 0u)
+                             | (p.entry.info.acceptedOptimized ? FlagOptimized : 0u);
+            r.pathOffset     = quint32(strings.size());
+            r.pathLength     = quint32(p.path.size());
+
+            const QByteArray codec = p.entry.info.codec.toLatin1().leftJustified(4, ' ', true);
+            std::memcpy(r.codec, codec.constData(), 4);
+
+            records.append(reinterpret_cast<const char *>(&r), sizeof(Record));
+            strings.append(p.path);
+        }
+
+        const Header header{ kMagic, kVersion, quint32(all.size()), quint32(strings.size()) };
+
+        QSaveFile out(filePath);
+        bool saved = out.open(QIODevice::WriteOnly);
+        if (saved) {
+            out.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+            out.write(records);
+            out.write(strings);
+        }
+
+        bool morePending = false;
+        {
+            QMutexLocker locker(&m_mutex);
+
+            // The old file must not stay mapped while it is replaced (Windows)
+            unmap();
+            if (saved)
+                saved = out.commit();
+
+            // Drop what was written; results that arrived meanwhile (or
+            // replaced a written one) stay for the next save
+            if (saved) {
+                for (auto it = written.constBegin(); it != written.constEnd(); ++it) {
+                    const auto current = m_overlay.constFind(it.key());
+                    if (current != m_overlay.constEnd()
+                        && current->fileSize == it->fileSize && current->mtimeMs == it->mtimeMs) {
+                        m_overlay.erase(current);
+                    }
+                }
+            }
+            m_saving    = false;
+            morePending = saved && !m_overlay.isEmpty();
+        }
+
+        if (saved) {
+            qInfo() << "[MediaIndex] Saved" << all.size() << "entries to" << filePath
+                    << "| pruned" << pruned << "deleted";
+        } else {
+            // Overlay is kept, so the next save retries
+            qWarning() << "[MediaIndex] Failed to write index:" << filePath << out.errorString();
+        }
+
+        // Re-map the current file (open() takes the lock itself)
+        open(filePath);
+
+        if (morePending)
+            QMetaObject::invokeMethod(this, [this]() { m_saveTimer.start(); }, Qt::QueuedConnection);
+    });
+}
@@ -0,0 +1,197 @@
+#include "core/MediaQuarantine.h"
+
+#include <QGuiApplication>
+#include <QSaveFile>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QDebug>
+
+MediaQuarantine *MediaQuarantine::s_instance = nullptr;
+
+static constexpr qint64 kMaxBackoffMs = 30 * 60 * 1000;
+
+// ──────────────────────────────────────────────
+// Constructor / Singleton
+// ──────────────────────────────────────────────
+MediaQuarantine::MediaQuarantine(QObject *parent)
+    : QObject(parent)
+{
+}
+
+MediaQuarantine *MediaQuarantine::instance()
+{
+    if (!s_instance) {
+        s_instance = new MediaQuarantine(qApp);
+    }
+    return s_instance;
+}
+
+void MediaQuarantine::setPolicy(int baseDelayMs, int threshold)
+{
+    m_baseDelayMs = qMax(100, baseDelayMs);
+    m_threshold   = qMax(1, threshold);
+}
+
+// ──────────────────────────────────────────────
+// Persistence
+// ──────────────────────────────────────────────
+// [ { "path": "...", "fileSize": 123, "failures": 3 }, ... ]
+bool MediaQuarantine::open(const QString &filePath)
+{
+    m_filePath = filePath;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    if (!doc.isArray()) {
+        qWarning() << "[MediaQuarantine] Ignoring unreadable quarantine list:" << filePath;
+        return false;
+    }
+
+    for (const QJsonValue &value : doc.array()) {
+        const QJsonObject entry = value.toObject();
+        Record record;
+        record.fileSize    = entry.value("fileSize").toInteger();
+        record.failures    = entry.value("failures").toInt();
+        record.quarantined = true;
+        m_records.insert(entry.value("path").toString(), record);
+    }
+
+    if (!m_records.isEmpty()) {
+        qWarning() << "[MediaQuarantine]" << m_records.size() << "file(s) quarantined:"
+                   << quarantined();
+    }
+    emit quarantineChanged();
+    return true;
+}
+
+void MediaQuarantine::save() const
+{
+    if (m_filePath.isEmpty())
+        return;
+
+    QJsonArray entries;
+    for (auto it = m_records.constBegin(); it != m_records.constEnd(); ++it) {
+        if (!it.value().quarantined)
+            continue;
+        entries.append(QJsonObject{
+            {"path",     it.key()},
+            {"fileSize", it.value().fileSize},
+            {"failures", it.value().failures},
+        });
+    }
+
+    QDir().mkpath(QFileInfo(m_filePath).absolutePath());
+
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[MediaQuarantine] Cannot write quarantine list:" << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(entries).toJson());
+    if (!file.commit())
+        qWarning() << "[MediaQuarantine] Failed to commit quarantine list:" << file.errorString();
+}
+
+// ──────────────────────────────────────────────
+// Lookup
+// ──────────────────────────────────────────────
+const MediaQuarantine::Record *MediaQuarantine::recordFor(const nctv::MediaItem &item) const
+{
+    const auto it = m_records.constFind(item.filePath);
+    if (it == m_records.constEnd())
+        return nullptr;
+
+    // A replaced file starts with a clean slate
+    if (it->fileSize != item.fileSize)
+        return nullptr;
+    return &it.value();
+}
+
+bool MediaQuarantine::isPlayable(const nctv::MediaItem &item) const
+{
+    if (m_records.isEmpty())
+        return true;
+
+    const Record *record = recordFor(item);
+    if (!record)
+        return true;
+    if (record->quarantined)
+        return false;
+    return QDateTime::currentMSecsSinceEpoch() >= record->retryAtMs;
+}
+
+bool MediaQuarantine::isQuarantined(const nctv::MediaItem &item) const
+{
+    const Record *record = recordFor(item);
+    return record && record->quarantined;
+}
+
+QStringList MediaQuarantine::quarantined() const
+{
+    QStringList paths;
+    for (auto it = m_records.constBegin(); it != m_records.constEnd(); ++it) {
+        if (it.value().quarantined)
+            paths.append(it.key());
+    }
+    paths.sort();
+    return paths;
+}
+
+// ──────────────────────────────────────────────
+// Updates
+// ──────────────────────────────────────────────
+void MediaQuarantine::recordFailure(const nctv::MediaItem &item)
+{
+    Record &record = m_records[item.filePath];
+    if (record.fileSize != item.fileSize) {
+        record = Record();
+        record.fileSize = item.fileSize;
+    }
+    if (record.quarantined)
+        return;
+
+    ++record.failures;
+    if (record.failures >= m_threshold) {
+        record.quarantined = true;
+        qWarning() << "[MediaQuarantine] Quarantined after" << record.failures
+                   << "failures:" << item.filePath;
+        save();
+        emit quarantineChanged();
+        return;
+    }
+
+    const qint64 delay = qMin(kMaxBackoffMs, qint64(m_baseDelayMs) << qMin(record.failures - 1, 20));
+    record.retryAtMs = QDateTime::currentMSecsSinceEpoch() + delay;
+    qWarning() << "[MediaQuarantine] Failure" << record.failures << "of" << m_threshold
+               << "for" << item.filePath << "- retry in" << delay << "ms";
+}
+
+void MediaQuarantine::recordSuccess(const QString &filePath)
+{
+    const auto it = m_records.find(filePath);
+    if (it == m_records.end())
+        return;
+
+    const bool wasQuarantined = it->quarantined;
+    m_records.erase(it);
+    if (wasQuarantined) {
+        save();
+        emit quarantineChanged();
+    }
+}
+
+void MediaQuarantine::clear()
+{
+    m_records.clear();
+    save();
+    emit quarantineChanged();
+    qInfo() << "[MediaQuarantine] Quarantine list cleared";
+}
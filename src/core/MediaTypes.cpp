@@ -0,0 +1,132 @@
+#include "core/MediaTypes.h"
+
+#include <QHash>
+#include <QFile>
+#include <QDebug>
+
+#include <cstring>
+#include <iterator>
+
+namespace nctv {
+namespace MediaTypes {
+
+// ──────────────────────────────────────────────
+// Extension Registry
+// ──────────────────────────────────────────────
+static const QHash<QString, MediaType> &extensionTable()
+{
+    // Built once from kExtensions (thread-safe static initialisation)
+    static const QHash<QString, MediaType> table = []() {
+        QHash<QString, MediaType> hash;
+        hash.reserve(std::size(kExtensions));
+        for (const ExtensionEntry &entry : kExtensions)
+            hash.insert(QString::fromLatin1(entry.extension), entry.type);
+        return hash;
+    }();
+    return table;
+}
+
+MediaType fromExtension(QStringView extension)
+{
+    if (extension.isEmpty())
+        return MediaType::Unknown;
+    return extensionTable().value(extension.toString().toLower(), MediaType::Unknown);
+}
+
+QStringList extensions(MediaType type)
+{
+    QStringList result;
+    for (const ExtensionEntry &entry : kExtensions) {
+        if (entry.type == type)
+            result.append(QString::fromLatin1(entry.extension));
+    }
+    return result;
+}
+
+// ──────────────────────────────────────────────
+// Content Sniffing
+// ──────────────────────────────────────────────
+static QString typeName(MediaType type)
+{
+    switch (type) {
+        case MediaType::Video:   return QStringLiteral("video");
+        case MediaType::Image:   return QStringLiteral("image");
+        case MediaType::Unknown: break;
+    }
+    return QStringLiteral("unknown");
+}
+
+MediaType sniff(const QByteArray &header)
+{
+    const auto at = [&header](int offset, const char *magic, int length) {
+        return header.size() >= offset + length
+            && std::memcmp(header.constData() + offset, magic, length) == 0;
+    };
+
+    // ── Images ──
+    if (at(0, "\xFF\xD8\xFF", 3))                      return MediaType::Image;   // JPEG
+    if (at(0, "\x89PNG\r\n\x1A\n", 8))                 return MediaType::Image;   // PNG
+    if (at(0, "GIF87a", 6) || at(0, "GIF89a", 6))      return MediaType::Image;   // GIF
+    if (at(0, "RIFF", 4) && at(8, "WEBP", 4))          return MediaType::Image;   // WebP
+    if (at(0, "BM", 2) && at(6, "\0\0\0\0", 4))        return MediaType::Image;   // BMP (reserved = 0)
+
+    // ── Containers ──
+    if (at(4, "ftyp", 4)) {
+        // ISO BMFF also carries HEIF/AVIF stills, which neither path shows
+        if (at(8, "heic", 4) || at(8, "heix", 4) || at(8, "mif1", 4)
+            || at(8, "msf1", 4) || at(8, "avif", 4)) {
+            return MediaType::Unknown;
+        }
+        return MediaType::Video;                                                   // MP4 / MOV / M4V
+    }
+    if (at(4, "moov", 4) || at(4, "mdat", 4) || at(4, "wide", 4))
+        return MediaType::Video;                                                   // Legacy QuickTime
+    if (at(0, "\x1A\x45\xDF\xA3", 4))                  return MediaType::Video;   // Matroska / WebM
+    if (at(0, "RIFF", 4) && at(8, "AVI ", 4))          return MediaType::Video;   // AVI
+    if (at(0, "\x30\x26\xB2\x75\x8E\x66\xCF\x11", 8))  return MediaType::Video;   // ASF / WMV
+    if (at(0, "FLV\x01", 4))                           return MediaType::Video;   // FLV
+    if (at(0, "\0\0\x01\xBA", 4) || at(0, "\0\0\x01\xB3", 4))
+        return MediaType::Video;                                                   // MPEG-PS / ES
+    if (header.size() >= 189 && header.at(0) == 0x47 && header.at(188) == 0x47)
+        return MediaType::Video;                                                   // MPEG-TS (two sync bytes)
+
+    // ── Text ──
+    const QByteArray text = header.trimmed();
+    if (text.startsWith("<svg") || (text.startsWith("<?xml") && text.contains("<svg")))
+        return MediaType::Image;                                                   // SVG
+
+    return MediaType::Unknown;
+}
+
+MediaType sniffFile(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return MediaType::Unknown;
+    return sniff(file.read(kSniffBytes));
+}
+
+MediaType classify(const QString &filePath, QStringView extension, bool sniffContent)
+{
+    const MediaType byName = fromExtension(extension);
+    if (!sniffContent)
+        return byName;
+
+    // Other extensions are left alone: "clip.mp4.part" is a copy in progress
+    if (byName == MediaType::Unknown && !extension.isEmpty())
+        return MediaType::Unknown;
+
+    // An unrecognised signature proves nothing; only a match overrides the name
+    const MediaType byContent = sniffFile(filePath);
+    if (byContent == MediaType::Unknown)
+        return byName;
+
+    if (byContent != byName) {
+        qInfo() << "[MediaTypes]" << filePath << "is named as" << typeName(byName)
+                << "but contains" << typeName(byContent);
+    }
+    return byContent;
+}
+
+} // namespace MediaTypes
+} // namespace nctv
@@ -0,0 +1,136 @@
+#include "core/ZonePlaylistModel.h"
+
+#include <QDebug>
+
+// ──────────────────────────────────────────────
+// Constructor
+// ──────────────────────────────────────────────
+ZonePlaylistModel::ZonePlaylistModel(const QString &zoneName, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_zoneName(zoneName)
+{
+}
+
+// ──────────────────────────────────────────────
+// QAbstractListModel
+// ──────────────────────────────────────────────
+int ZonePlaylistModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(m_items.size());
+}
+
+QVariant ZonePlaylistModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_items.size())
+        return QVariant();
+
+    const nctv::MediaItem &item = m_items.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+    case FilePathRole:   return item.filePath;
+    case FileNameRole:   return item.filePath.mid(item.filePath.lastIndexOf(QLatin1Char('/')) + 1);
+    case MediaTypeRole:
+        switch (item.type) {
+        case nctv::MediaType::Video: return QStringLiteral("video");
+        case nctv::MediaType::Image: return QStringLiteral("image");
+        default:                     return QStringLiteral("unknown");
+        }
+    case OptimizedRole:  return item.optimized;
+    case FileSizeRole:   return item.fileSize;
+    case WidthRole:      return item.info.width;
+    case HeightRole:     return item.info.height;
+    case CodecRole:      return item.info.codec;
+    case DurationRole:   return item.info.durationMs;
+    case Is4KRole:       return item.info.is4K();
+    case ProbedRole:     return item.info.valid;
+    }
+    return QVariant();
+}
+
+QHash<int, QByteArray> ZonePlaylistModel::roleNames() const
+{
+    return {
+        { FilePathRole,  "filePath"   },
+        { FileNameRole,  "fileName"   },
+        { MediaTypeRole, "mediaType"  },
+        { OptimizedRole, "optimized"  },
+        { FileSizeRole,  "fileSize"   },
+        { WidthRole,     "width"      },
+        { HeightRole,    "height"     },
+        { CodecRole,     "codec"      },
+        { DurationRole,  "durationMs" },
+        { Is4KRole,      "is4K"       },
+        { ProbedRole,    "probed"     },
+    };
+}
+
+// ──────────────────────────────────────────────
+// Accessors
+// ──────────────────────────────────────────────
+QString ZonePlaylistModel::zoneName() const                      { return m_zoneName; }
+int     ZonePlaylistModel::count() const                         { return int(m_items.size()); }
+const QList<nctv::MediaItem> &ZonePlaylistModel::items() const   { return m_items; }
+
+QStringList ZonePlaylistModel::filePaths() const
+{
+    QStringList paths;
+    paths.reserve(m_items.size());
+    for (const nctv::MediaItem &item : m_items)
+        paths.append(item.filePath);
+    return paths;
+}
+
+int ZonePlaylistModel::indexOf(const QString &filePath) const
+{
+    return m_rows.value(filePath, -1);
+}
+
+QVariantMap ZonePlaylistModel::get(int row) const
+{
+    QVariantMap map;
+    const QModelIndex idx = index(row);
+    if (!idx.isValid())
+        return map;
+
+    const QHash<int, QByteArray> roles = roleNames();
+    for (auto it = roles.constBegin(); it != roles.constEnd(); ++it)
+        map.insert(QString::fromUtf8(it.value()), data(idx, it.key()));
+    return map;
+}
+
+// ──────────────────────────────────────────────
+// Updates
+// ──────────────────────────────────────────────
+bool ZonePlaylistModel::setItems(const QList<nctv::MediaItem> &items)
+{
+    if (items == m_items)
+        return false;
+
+    const int oldCount = count();
+
+    beginResetModel();
+    m_items = items;
+    m_rows.clear();
+    m_rows.reserve(m_items.size());
+    for (int row = 0; row < m_items.size(); ++row)
+        m_rows.insert(m_items.at(row).filePath, row);
+    endResetModel();
+
+    if (count() != oldCount)
+        emit countChanged();
+    return true;
+}
+
+void ZonePlaylistModel::updateInfo(const QString &filePath, const nctv::MediaInfo &info)
+{
+    const int row = indexOf(filePath);
+    if (row < 0)
+        return;
+
+    m_items[row].info = info;
+    if (info.acceptedOptimized)
+        m_items[row].optimized = true;
+    const QModelIndex idx = index(row);
+    emit dataChanged(idx, idx, { OptimizedRole, WidthRole, HeightRole, CodecRole, DurationRole,
+                                 Is4KRole, ProbedRole });
+}
@@ -6,6 +6,7 @@
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QQmlEngine>
 #include <QQuickStyle>
 #include <QDir>
 #include <QFile>
@@ -16,11 +17,19 @@
 #include <QMutexLocker>
 
 #include "core/Config.h"
+#include "core/MediaIndex.h"
+#include "core/MediaCache.h"
+#include "core/MediaQuarantine.h"
 #include "services/PlaylistService.h"
 #include "services/CliService.h"
 #include "services/PidService.h"
 #include "services/WindowService.h"
+#include "services/ReadaheadService.h"
+#include "services/DecodeBudget.h"
 #include "player/ZonePlayer.h"
+#include "player/VideoSurfaceItem.h"
+#include "player/ZoneImageProvider.h"
+#include "utils/VideoOptimizer.h"
 
 // ──────────────────────────────────────────────
 // File-Based Rotating Logger
@@ -110,10 +119,46 @@ int main(int argc, char *argv[])
     qInfo() << "Configuration loaded. Kiosk mode:" << config.kioskMode()
             << "| Image duration:" << config.imageDurationMs() << "ms";
 
-    // Initialize playlist service
+    // Persistent media metadata (probe results survive restarts)
+    MediaIndex::instance()->open(config.dataPath() + QStringLiteral("/media-index.bin"));
+
+    // Files that repeatedly failed to play (skipped until replaced)
+    MediaQuarantine::instance()->setPolicy(config.retryIntervalMs(), config.quarantineAfterFailures());
+    MediaQuarantine::instance()->open(config.dataPath() + QStringLiteral("/quarantine.json"));
+
+    // Decoded media cache, sized before any worker touches it
+    MediaCache::instance()->setBudgetMB(config.cacheBudgetMB());
+
+    // Page-cache prefetch of upcoming videos, shared by all zones
+    ReadaheadService::instance()->setBudget(config.readaheadBudgetMBps(),
+                                            config.readaheadHeadMB(),
+                                            config.readaheadWholeFileMB());
+
+    // Hardware decoder capacity arbitrated between the zones
+    DecodeBudget::instance()->setCapacity(config.decodeCapacity(), config.decodeSoftwareMaxCost());
+
+    // Background HEVC transcoder (started once the UI is up)
+    VideoOptimizer videoOptimizer;
+    videoOptimizer.setPlaylistRoot(config.playlistRoot());
+    videoOptimizer.setOptimizedSuffix(config.optimizedSuffix());
+    videoOptimizer.setNiceness(config.optimizerNiceness());
+    videoOptimizer.setConcurrency(config.optimizerJobs());
+    videoOptimizer.setAcceptMaxBitrate(config.acceptMaxBitrateKbps());
+    videoOptimizer.setZoneLayout(nctv::zoneDefinitionsFor(config.targetWidth(), config.targetHeight()),
+                                 QSize(config.targetWidth(), config.targetHeight()));
+    // Before the first scan: interrupted encodes leave nothing behind to list
+    videoOptimizer.openJournal(config.dataPath() + QStringLiteral("/optimizer-journal.json"));
+
+    // Initialize playlist service (scan runs in the background; zones start
+    // as their lists arrive via zonePlaylistChanged)
     PlaylistService playlistService;
     playlistService.setPlaylistRoot(config.playlistRoot());
-    playlistService.scanAll();
+    playlistService.setContentSniffing(config.sniffMediaTypes());
+    playlistService.setSnapshotPath(config.dataPath() + QStringLiteral("/playlist-snapshot.bin"));
+    playlistService.loadSnapshot();   // Last known lists: zones start at once
+    playlistService.scanAll();        // Reconcile with the filesystem in the background
+    if (config.watchPlaylists())
+        playlistService.startWatching();
 
     // Initialize zone players (one per zone)
     ZonePlayer backgroundPlayer("background");
@@ -121,11 +166,25 @@ int main(int argc, char *argv[])
     ZonePlayer horizontalPlayer("horizontal");
     ZonePlayer verticalPlayer("vertical");
 
+    for (ZonePlayer *player : { &backgroundPlayer, &mainPlayer, &horizontalPlayer, &verticalPlayer }) {
+        player->setPrerollEnabled(config.prerollEnabled());
+        player->setRetryInterval(config.retryIntervalMs());
+        player->setOcclusionPolicy(config.occlusionPolicy());
+        player->setVlcOptions(config.vlcOptions(player->zoneName()));
+        player->setRenderMode(config.renderMode());
+    }
+
     // ──────────────────────────────────────────────
     // QML Engine Setup & C++ → QML Bridge
     // ──────────────────────────────────────────────
     QQmlApplicationEngine engine;
 
+    // Scene graph video layer used by the zone QML files
+    qmlRegisterType<VideoSurfaceItem>("Nctv.Video", 1, 0, "VideoSurface");
+
+    // Zone images, pre-decoded off-thread at zone size (engine takes ownership)
+    engine.addImageProvider(QStringLiteral("zone"), new ZoneImageProvider());
+
     // Expose C++ objects to QML
     QQmlContext *rootContext = engine.rootContext();
     rootContext->setContextProperty("appConfig",         &config);
@@ -137,6 +196,10 @@ int main(int argc, char *argv[])
 
     rootContext->setContextProperty("cliService",        &cliService);
     rootContext->setContextProperty("windowService",     WindowService::instance());
+    rootContext->setContextProperty("mediaCache",        MediaCache::instance());
+    rootContext->setContextProperty("mediaQuarantine",   MediaQuarantine::instance());
+    rootContext->setContextProperty("decodeBudget",      DecodeBudget::instance());
+    rootContext->setContextProperty("videoOptimizer",    &videoOptimizer);
 
     // Get primary screen resolution
     QScreen *primaryScreen = QGuiApplication::primaryScreen();
@@ -164,20 +227,30 @@ int main(int argc, char *argv[])
 
     qInfo() << "NCTV Player UI loaded successfully.";
 
-    // Start video optimization in background after UI is up
-    /*
-    // Video Optimizer Removed
-    QObject::connect(&videoOptimizer, &VideoOptimizer::optimizationFinished,
-                     [&playlistService]() {
-        qInfo() << "Video optimization complete. Re-scanning playlists...";
-        playlistService.scanAll();
-    });
-    videoOptimizer.startOptimization();
-    */
+    // Start video optimization in background after UI is up. Zones are
+    // already playing the raw files; each finished file triggers a rescan
+    // (only its zone is re-walked) and the zone picks it up at its next loop
+    if (config.optimizerEnabled()) {
+        // Sampled only while a run is active
+        videoOptimizer.setSchedule(config.offPeakWindows(), config.minHeadroomPercent());
+        QObject::connect(&videoOptimizer, &VideoOptimizer::fileOptimized,
+                         &playlistService, [&playlistService](const QString &, const QString &outputPath) {
+            qInfo() << "Optimized video ready:" << outputPath << "- re-scanning playlists...";
+            playlistService.scanAll();
+        });
+        // Files that already meet the target are listed as optimized as-is
+        QObject::connect(&videoOptimizer, &VideoOptimizer::fileAccepted,
+                         &playlistService, &PlaylistService::markAccepted);
+        // Raw files copied in later are picked up after the rescan settles
+        QObject::connect(&playlistService, &PlaylistService::scanComplete,
+                         &videoOptimizer, &VideoOptimizer::startOptimization);
+        videoOptimizer.startOptimization();
+    }
 
     // Cleanup on exit
     QObject::connect(&app, &QGuiApplication::aboutToQuit, [&]() {
         qInfo() << "=== NCTV Player shutting down ===";
+        videoOptimizer.cancelOptimization();
         backgroundPlayer.stop();
         mainPlayer.stop();
         horizontalPlayer.stop();
@@ -0,0 +1,110 @@
+#include "player/VideoFrameSink.h"
+
+#include <QMutexLocker>
+#include <QDebug>
+
+#include <cstring>
+
+// ──────────────────────────────────────────────
+// Constructor
+// ──────────────────────────────────────────────
+VideoFrameSink::VideoFrameSink(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void VideoFrameSink::attach(libvlc_media_player_t *player)
+{
+    if (!player) return;
+
+    libvlc_video_set_callbacks(player, lockCallback, unlockCallback, displayCallback, this);
+    libvlc_video_set_format_callbacks(player, setupCallback, cleanupCallback);
+}
+
+// ──────────────────────────────────────────────
+// Render Thread
+// ──────────────────────────────────────────────
+QImage VideoFrameSink::takeFrame(bool *isNew)
+{
+    QMutexLocker locker(&m_mutex);
+
+    const bool changed = (m_ready >= 0);
+    if (changed) {
+        m_front = m_ready;
+        m_ready = -1;
+    }
+    if (isNew)
+        *isNew = changed;
+
+    return m_front >= 0 ? m_buffers[m_front] : QImage();
+}
+
+// ──────────────────────────────────────────────
+// libVLC Video Callbacks (vout thread)
+// ──────────────────────────────────────────────
+unsigned VideoFrameSink::setupCallback(void **opaque, char *chroma, unsigned *width, unsigned *height,
+                                       unsigned *pitches, unsigned *lines)
+{
+    auto *self = static_cast<VideoFrameSink *>(*opaque);
+
+    // RV32 is laid out as QImage::Format_RGB32 on little-endian targets
+    std::memcpy(chroma, "RV32", 4);
+    pitches[0] = *width * 4;
+    lines[0]   = *height;
+
+    QMutexLocker locker(&self->m_mutex);
+
+    // Same geometry as the previous video: keep the buffers. Otherwise
+    // replace them; a frame still held by the render thread stays valid
+    // through QImage's shared data.
+    const QSize size(int(*width), int(*height));
+    if (self->m_buffers[0].size() != size) {
+        for (QImage &buffer : self->m_buffers) {
+            buffer = QImage(size, QImage::Format_RGB32);
+            buffer.fill(Qt::black);
+        }
+        qDebug() << "[VideoFrameSink] Allocated" << kBufferCount << "frame buffers" << size;
+    }
+
+    self->m_ready   = -1;
+    self->m_front   = -1;
+    return 1;
+}
+
+void VideoFrameSink::cleanupCallback(void *opaque)
+{
+    // Buffers are kept for the next video of the same size
+    Q_UNUSED(opaque);
+}
+
+void *VideoFrameSink::lockCallback(void *opaque, void **planes)
+{
+    auto *self = static_cast<VideoFrameSink *>(opaque);
+    QMutexLocker locker(&self->m_mutex);
+
+    // Any buffer that is neither waiting nor on screen
+    int index = 0;
+    while (index == self->m_ready || index == self->m_front)
+        ++index;
+
+    // constBits() does not detach: VLC writes into the shared buffer itself
+    planes[0] = const_cast<uchar *>(self->m_buffers[index].constBits());
+    return reinterpret_cast<void *>(quintptr(index));
+}
+
+void VideoFrameSink::unlockCallback(void *opaque, void *picture, void *const *planes)
+{
+    Q_UNUSED(opaque);
+    Q_UNUSED(picture);
+    Q_UNUSED(planes);
+}
+
+void VideoFrameSink::displayCallback(void *opaque, void *picture)
+{
+    auto *self = static_cast<VideoFrameSink *>(opaque);
+    {
+        QMutexLocker locker(&self->m_mutex);
+        self->m_ready = int(reinterpret_cast<quintptr>(picture));
+    }
+    emit self->frameReady();
+}
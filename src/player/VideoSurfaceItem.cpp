@@ -0,0 +1,165 @@
+#include "player/VideoSurfaceItem.h"
+#include "player/ZonePlayer.h"
+
+#include <QQuickWindow>
+#include <QSGSimpleTextureNode>
+#include <QSGDynamicTexture>
+#include <QDebug>
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+#include <rhi/qrhi.h>
+
+#include <memory>
+
+namespace {
+
+// One texture per frame size, written in place: each new frame is an
+// upload into the existing QRhiTexture, recorded on the render thread's
+// resource batch. A size change (next video) recreates it.
+class VideoFrameTexture : public QSGDynamicTexture
+{
+public:
+    // Render thread, GUI thread blocked. The image stays valid until the
+    // sink's next takeFrame(), i.e. past this frame's upload
+    void setFrame(const QImage &frame)
+    {
+        m_pending = frame;
+        m_size    = frame.size();
+    }
+
+    qint64 comparisonKey() const override
+    {
+        return qint64(qintptr(m_texture ? static_cast<const void *>(m_texture.get()) : this));
+    }
+    QRhiTexture *rhiTexture() const override { return m_texture.get(); }
+    QSize textureSize() const override       { return m_size; }
+    bool hasAlphaChannel() const override    { return false; }
+    bool hasMipmaps() const override         { return false; }
+    bool updateTexture() override            { return false; }
+
+    void commitTextureOperations(QRhi *rhi, QRhiResourceUpdateBatch *resourceUpdates) override
+    {
+        if (m_pending.isNull())
+            return;
+
+        // RV32 frames are BGRA in memory; converted only where that
+        // format cannot be sampled
+        const bool bgra = rhi->isTextureFormatSupported(QRhiTexture::BGRA8);
+        const QRhiTexture::Format format = bgra ? QRhiTexture::BGRA8 : QRhiTexture::RGBA8;
+        if (!m_texture || m_texture->pixelSize() != m_size || m_texture->format() != format) {
+            m_texture.reset(rhi->newTexture(format, m_size));
+            if (!m_texture->create()) {
+                qWarning() << "[VideoSurfaceItem] Failed to create frame texture" << m_size;
+                m_texture.reset();
+                m_pending = QImage();
+                return;
+            }
+        }
+
+        resourceUpdates->uploadTexture(m_texture.get(), bgra ? m_pending
+                                                             : m_pending.convertToFormat(QImage::Format_RGBA8888));
+        m_pending = QImage();
+    }
+
+private:
+    std::unique_ptr<QRhiTexture> m_texture;
+    QImage m_pending;
+    QSize  m_size;
+};
+
+} // namespace
+#endif
+
+// ──────────────────────────────────────────────
+// Constructor
+// ──────────────────────────────────────────────
+VideoSurfaceItem::VideoSurfaceItem(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+ZonePlayer *VideoSurfaceItem::player() const { return m_player; }
+
+void VideoSurfaceItem::setPlayer(ZonePlayer *player)
+{
+    if (m_player == player)
+        return;
+
+    if (m_player)
+        disconnect(m_player, nullptr, this, nullptr);
+
+    m_player = player;
+    if (m_player) {
+        connect(m_player, &ZonePlayer::activeFrameSinkChanged,
+                this, &VideoSurfaceItem::onActiveFrameSinkChanged);
+    }
+
+    onActiveFrameSinkChanged();
+    emit playerChanged();
+}
+
+void VideoSurfaceItem::onActiveFrameSinkChanged()
+{
+    const QSharedPointer<VideoFrameSink> sink = m_player ? m_player->activeFrameSink()
+                                                         : QSharedPointer<VideoFrameSink>();
+    if (sink == m_sink)
+        return;
+
+    if (m_sink)
+        disconnect(m_sink.data(), nullptr, this, nullptr);
+
+    // Frames arrive on the VLC vout thread; schedule a repaint on ours
+    m_sink = sink;
+    if (m_sink) {
+        connect(m_sink.data(), &VideoFrameSink::frameReady,
+                this, &QQuickItem::update, Qt::QueuedConnection);
+    }
+    update();
+}
+
+// ──────────────────────────────────────────────
+// Scene Graph (render thread, GUI thread blocked)
+// ──────────────────────────────────────────────
+QSGNode *VideoSurfaceItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data)
+{
+    Q_UNUSED(data);
+    auto *node = static_cast<QSGSimpleTextureNode *>(oldNode);
+
+    bool isNew = false;
+    const QImage frame = m_sink ? m_sink->takeFrame(&isNew) : QImage();
+    if (frame.isNull() || !window()) {
+        delete node;
+        return nullptr;
+    }
+
+    if (!node) {
+        node = new QSGSimpleTextureNode();
+        node->setOwnsTexture(true);
+        node->setFiltering(QSGTexture::Linear);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+        node->setTexture(new VideoFrameTexture);
+        isNew = true;
+#endif
+    }
+
+    // Upload only when the sink produced a new frame
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+    if (isNew) {
+        static_cast<VideoFrameTexture *>(node->texture())->setFrame(frame);
+        node->markDirty(QSGNode::DirtyMaterial);
+    }
+#else
+    // No public QRhi before Qt 6.6: a texture per frame, the previous one
+    // released by the node (ownsTexture)
+    if (isNew || !node->texture())
+        node->setTexture(window()->createTextureFromImage(frame));
+#endif
+
+    // Best fit, preserving the source aspect ratio (letterbox)
+    const QSizeF fitted = QSizeF(frame.size()).scaled(size(), Qt::KeepAspectRatio);
+    node->setRect(QRectF((width() - fitted.width()) / 2.0,
+                         (height() - fitted.height()) / 2.0,
+                         fitted.width(), fitted.height()));
+    return node;
+}
@@ -0,0 +1,186 @@
+#include "player/VlcRuntime.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QMutexLocker>
+#include <QDebug>
+
+#include <cstdio>
+
+QMutex                   VlcRuntime::s_mutex;
+QWeakPointer<VlcRuntime> VlcRuntime::s_shared;
+
+// ──────────────────────────────────────────────
+// Shared Instance
+// ──────────────────────────────────────────────
+QSharedPointer<VlcRuntime> VlcRuntime::acquire()
+{
+    QMutexLocker locker(&s_mutex);
+
+    QSharedPointer<VlcRuntime> runtime = s_shared.toStrongRef();
+    if (!runtime) {
+        runtime.reset(new VlcRuntime());
+        s_shared = runtime;
+    }
+    return runtime;
+}
+
+// ──────────────────────────────────────────────
+// Constructor / Destructor
+// ──────────────────────────────────────────────
+VlcRuntime::VlcRuntime()
+{
+#ifdef Q_OS_WIN
+    // Set VLC plugin path for Windows (relative to executable)
+    QString pluginPath = QCoreApplication::applicationDirPath() + QStringLiteral("/plugins");
+    if (QDir(pluginPath).exists()) {
+        qputenv("VLC_PLUGIN_PATH", pluginPath.toUtf8());
+        qInfo() << "[VlcRuntime] VLC_PLUGIN_PATH:" << pluginPath;
+    }
+#endif
+
+#ifdef Q_OS_WIN
+    const char *args[] = {
+        "--no-xlib",              // No X11 threading issues (harmless on Windows)
+        "--no-video-title-show",  // Don't overlay filename on video
+        "--quiet",                // Reduce VLC noise
+        "--no-audio",             // Digital signage typically muted
+    };
+#else
+    // Linux / Raspberry Pi Arguments
+    const char *args[] = {
+        "--no-osd",
+        "--drop-late-frames",
+
+        // Hardware decode, but translate the pixels for X11 compatibility
+        // Fixes "get_buffer() failed" / "video output creation failed" on Pi X11
+        "--avcodec-hw=v4l2m2m-copy",
+
+        // Tell VLC to route the video through the X11 server (since we are in X11)
+        "--vout=xcb_x11",
+
+        // Force the X11 window to cover the entire TV (for the 4K overlay case)
+        "--fullscreen",
+
+        // Ensure it renders above your Qt UI
+        "--video-on-top",
+
+        "--no-video-title-show",
+        "--verbose=2",            // Keep verbose logging for debugging
+        "--no-audio",
+        "--no-xlib"               // Crucial: Tell VLC not to interact with the X11 desktop directly in a way that conflicts with Qt
+    };
+#endif
+
+    m_instance = libvlc_new(sizeof(args) / sizeof(args[0]), args);
+    if (!m_instance) {
+        qCritical() << "[VlcRuntime] FATAL: Failed to create libVLC instance";
+        return;
+    }
+
+    // Register Log Callback (one for all zones, routed by emitting player)
+    libvlc_log_set(m_instance, logCallback, this);
+
+    qInfo() << "[VlcRuntime] Shared libVLC instance created";
+}
+
+VlcRuntime::~VlcRuntime()
+{
+    if (m_instance) {
+        libvlc_log_unset(m_instance);
+        libvlc_release(m_instance);
+        m_instance = nullptr;
+    }
+    qInfo() << "[VlcRuntime] Shared libVLC instance released";
+}
+
+bool               VlcRuntime::isValid() const  { return m_instance != nullptr; }
+libvlc_instance_t *VlcRuntime::instance() const { return m_instance; }
+
+// ──────────────────────────────────────────────
+// Media Players
+// ──────────────────────────────────────────────
+libvlc_media_player_t *VlcRuntime::createPlayer(const QString &zoneName)
+{
+    if (!m_instance)
+        return nullptr;
+
+    libvlc_media_player_t *player = libvlc_media_player_new(m_instance);
+    if (player) {
+        QMutexLocker locker(&m_mutex);
+        m_playerZones.insert(reinterpret_cast<quintptr>(player), zoneName);
+    }
+    return player;
+}
+
+void VlcRuntime::releasePlayer(libvlc_media_player_t *player)
+{
+    if (!player)
+        return;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_playerZones.remove(reinterpret_cast<quintptr>(player));
+    }
+    libvlc_media_player_release(player);
+}
+
+// ──────────────────────────────────────────────
+// Media
+// ──────────────────────────────────────────────
+libvlc_media_t *VlcRuntime::createMedia(const QString &filePath, const QStringList &options) const
+{
+    if (!m_instance)
+        return nullptr;
+
+    libvlc_media_t *media = libvlc_media_new_path(m_instance,
+        QDir::toNativeSeparators(filePath).toUtf8().constData());
+    if (!media)
+        return nullptr;
+
+    for (const QString &option : options)
+        libvlc_media_add_option(media, option.toUtf8().constData());
+
+    return media;
+}
+
+// ──────────────────────────────────────────────
+// Static VLC Log Callback (Redirects to Qt/Systemd)
+// ──────────────────────────────────────────────
+QString VlcRuntime::zoneForObject(quintptr objectId) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_playerZones.value(objectId);
+}
+
+void VlcRuntime::logCallback(void *data, int level, const libvlc_log_t *ctx, const char *fmt, va_list args)
+{
+    // Filter out noisy debug/notice logs unless needed
+    // LIBVLC_DEBUG=0, LIBVLC_NOTICE=2, LIBVLC_WARNING=3, LIBVLC_ERROR=4
+    if (level < LIBVLC_WARNING) return;
+
+    auto *self = static_cast<VlcRuntime *>(data);
+
+    char buffer[1024];
+    vsnprintf(buffer, sizeof(buffer), fmt, args);
+
+    // The object id is the emitting vlc_object_t. Messages raised by a media
+    // player itself map back to its zone; decoder/vout/demux objects are
+    // children that libVLC does not expose, so they are tagged by module.
+    const char *module     = nullptr;
+    const char *objectType = nullptr;
+    uintptr_t   objectId   = 0;
+    libvlc_log_get_context(ctx, &module, nullptr, nullptr);
+    libvlc_log_get_object(ctx, &objectType, nullptr, &objectId);
+
+    QString tag = self ? self->zoneForObject(objectId) : QString();
+    if (tag.isEmpty())
+        tag = QString::fromUtf8(module ? module : (objectType ? objectType : "core"));
+
+    switch (level) {
+        case LIBVLC_NOTICE:  qInfo() << "[LibVLC]" << tag << buffer; break;
+        case LIBVLC_WARNING: qWarning() << "[LibVLC]" << tag << buffer; break;
+        case LIBVLC_ERROR:   qCritical() << "[LibVLC]" << tag << buffer; break;
+        default:             qDebug() << "[LibVLC]" << tag << buffer; break;
+    }
+}
@@ -0,0 +1,31 @@
+#include "player/ZoneImageProvider.h"
+#include "services/ImageDecodeService.h"
+
+#include <QDebug>
+
+ZoneImageProvider::ZoneImageProvider()
+    : QQuickImageProvider(QQuickImageProvider::Image,
+                          QQmlImageProviderBase::ForceAsynchronousImageLoading)
+{
+    // Create the decode service on the GUI thread, before any loader thread asks
+    ImageDecodeService::instance();
+}
+
+QImage ZoneImageProvider::requestImage(const QString &id, QSize *size, const QSize &requestedSize)
+{
+    QString filePath;
+    QSize   targetSize;
+    if (!ImageDecodeService::parseProviderId(id, filePath, targetSize)) {
+        qWarning() << "[ZoneImageProvider] Malformed image id:" << id;
+        return QImage();
+    }
+
+    // An explicit sourceSize on the Image element wins over the zone size
+    if (requestedSize.isValid())
+        targetSize = requestedSize;
+
+    const QImage image = ImageDecodeService::instance()->image(filePath, targetSize);
+    if (size)
+        *size = image.size();
+    return image;
+}
@@ -1,29 +1,31 @@
 #include "player/ZonePlayer.h"
 #include "services/WindowService.h"
+#include "core/MediaQuarantine.h"
+#include "services/MediaProbeService.h"
+#include "services/ImageDecodeService.h"
+#include "services/ReadaheadService.h"
+#include "services/DecodeBudget.h"
 
-#include <QFileInfo>
+#include <QSet>
 #include <QDebug>
-#include <QUrl>
-#include <QDir>
-#include <QCoreApplication>
 #include <QGuiApplication>
-#include <QThread>
+
+#include <utility>
+
+// Longest a video start waits for decode capacity before the zone moves on
+static constexpr qint64 kMaxDecodeWaitMs = 60 * 1000;
+
+// A rendition fits a zone when it covers at least this fraction of each side
+static constexpr double kRenditionCoverage = 0.98;
+
+// Playing this long (or to the end) clears a video's failure record: a file
+// that decodes its first frames and then errors has not recovered
+static constexpr int kSuccessPlayMs = 10 * 1000;
 
 #ifdef Q_OS_WIN
 #include <windows.h>
 #endif
 
-// ──────────────────────────────────────────────
-// Supported Extensions
-// ──────────────────────────────────────────────
-const QStringList ZonePlayer::s_imageExtensions = {
-    "jpg", "jpeg", "png", "bmp", "gif", "webp", "svg"
-};
-
-const QStringList ZonePlayer::s_videoExtensions = {
-    "mp4", "mkv", "avi", "mov", "wmv", "flv", "webm", "ts", "m4v", "mpg", "mpeg"
-};
-
 // ──────────────────────────────────────────────
 // Constructor / Destructor
 // ──────────────────────────────────────────────
@@ -35,6 +37,28 @@ ZonePlayer::ZonePlayer(const QString &zoneName, QObject *parent)
     m_imageTimer.setSingleShot(true);
     connect(&m_imageTimer, &QTimer::timeout, this, &ZonePlayer::onImageTimerTimeout);
 
+    // Idle retry (nothing playable right now)
+    m_retryTimer.setSingleShot(true);
+    connect(&m_retryTimer, &QTimer::timeout, this, &ZonePlayer::onRetryTimerTimeout);
+
+    // Failure record cleared once the current video has played a while
+    m_successTimer.setSingleShot(true);
+    m_successTimer.setInterval(kSuccessPlayMs);
+    connect(&m_successTimer, &QTimer::timeout, this, [this]() {
+        if (m_successPath == m_currentMediaPath)
+            MediaQuarantine::instance()->recordSuccess(m_successPath);
+    });
+
+    // Delayed video start (hardware decoder busy in other zones)
+    m_budgetTimer.setSingleShot(true);
+    connect(&m_budgetTimer, &QTimer::timeout, this, &ZonePlayer::onDecodeBudgetRetry);
+    connect(DecodeBudget::instance(), &DecodeBudget::capacityFreed,
+            this, &ZonePlayer::onDecodeBudgetRetry);
+
+    // Video metadata arrives asynchronously from the shared probe pool
+    connect(MediaProbeService::instance(), &MediaProbeService::probeFinished,
+            this, &ZonePlayer::onProbeFinished);
+
     initVlc();
     qInfo() << "[ZonePlayer]" << m_zoneName << "created";
 }
@@ -44,125 +68,145 @@ ZonePlayer::~ZonePlayer()
     stop();
     releaseVlc();
     destroyZoneWindow();
+    destroyStandbyWindow();
     qInfo() << "[ZonePlayer]" << m_zoneName << "destroyed";
 }
 
 // ──────────────────────────────────────────────
-// Static VLC Log Callback (Redirects to Qt/Systemd)
+// libVLC Initialization
 // ──────────────────────────────────────────────
-static void vlcLogCallback(void *data, int level, const libvlc_log_t *ctx, const char *fmt, va_list args)
+void ZonePlayer::initVlc()
 {
-    Q_UNUSED(data);
-    Q_UNUSED(ctx);
+    // All zones share one libVLC instance; only the players are per zone
+    m_vlc = VlcRuntime::acquire();
+    if (!m_vlc->isValid()) {
+        qCritical() << "[ZonePlayer]" << m_zoneName << "FATAL: Failed to create libVLC instance";
+        emit errorOccurred("Failed to create libVLC instance");
+        m_vlc.reset();
+        return;
+    }
 
-    // Filter out noisy debug/notice logs unless needed
-    // LIBVLC_DEBUG=0, LIBVLC_NOTICE=2, LIBVLC_WARNING=3, LIBVLC_ERROR=4
-    if (level < LIBVLC_WARNING) return; 
+    // Embedded mode is the common case; its window is attached once the
+    // zone geometry and parent window are known (createZoneWindow)
+    m_embeddedPlayer = createPooledPlayer(OutputMode::Embedded, m_zoneWindow);
+    if (!m_embeddedPlayer) {
+        qCritical() << "[ZonePlayer]" << m_zoneName << "FATAL: Failed to create libVLC media player";
+        emit errorOccurred("Failed to create libVLC media player");
+        return;
+    }
+    m_vlcPlayer = m_embeddedPlayer;
+    m_vlcEvents = libvlc_media_player_event_manager(m_vlcPlayer);
 
-    char buffer[1024];
-    vsnprintf(buffer, sizeof(buffer), fmt, args);
+    qInfo() << "[ZonePlayer]" << m_zoneName << "libVLC player initialized (shared runtime)";
+}
 
-    switch (level) {
-        case LIBVLC_NOTICE:  qInfo() << "[LibVLC]" << buffer; break;
-        case LIBVLC_WARNING: qWarning() << "[LibVLC]" << buffer; break;
-        case LIBVLC_ERROR:   qCritical() << "[LibVLC]" << buffer; break;
-        default:             qDebug() << "[LibVLC]" << buffer; break;
-    }
+void ZonePlayer::attachPlayerEvents(libvlc_media_player_t *player)
+{
+    libvlc_event_manager_t *events = libvlc_media_player_event_manager(player);
+    if (!events) return;
+
+    libvlc_event_attach(events, libvlc_MediaPlayerEndReached,
+                        vlcEventCallback, this);
+    libvlc_event_attach(events, libvlc_MediaPlayerEncounteredError,
+                        vlcEventCallback, this);
+    libvlc_event_attach(events, libvlc_MediaPlayerPlaying,
+                        vlcEventCallback, this);
+
+    if (player == m_vlcPlayer)
+        m_vlcEvents = events;
+}
+
+void ZonePlayer::releaseVlc()
+{
+    releaseStandby();
+    releaseModePlayers(OutputMode::Embedded);
+    releaseModePlayers(OutputMode::Overlay);
+    m_vlcPlayer = nullptr;
+    m_vlcEvents = nullptr;
+    m_vlc.reset();
 }
 
 // ──────────────────────────────────────────────
-// libVLC Initialization
+// Mode-aware Player Pool
 // ──────────────────────────────────────────────
-void ZonePlayer::initVlc()
+// A player's output (child window vs. fullscreen overlay) is set up once
+// when it is created. Consecutive items in the same mode only swap the
+// media on the existing player; players are destroyed and recreated only
+// when the zone switches output mode.
+libvlc_media_player_t *ZonePlayer::createPooledPlayer(OutputMode mode, QWindow *window)
 {
-#ifdef Q_OS_WIN
-    // Set VLC plugin path for Windows (relative to executable)
-    static bool pluginPathSet = false;
-    if (!pluginPathSet) {
-        QString pluginPath = QCoreApplication::applicationDirPath() + QStringLiteral("/plugins");
-        if (QDir(pluginPath).exists()) {
-            qputenv("VLC_PLUGIN_PATH", pluginPath.toUtf8());
-            qInfo() << "[ZonePlayer] VLC_PLUGIN_PATH:" << pluginPath;
-        }
-        pluginPathSet = true;
-    }
-#endif
+    if (!m_vlc)
+        return nullptr;
+
+    libvlc_media_player_t *player = m_vlc->createPlayer(m_zoneName);
+    if (!player)
+        return nullptr;
+
+    attachPlayerEvents(player);
 
+    if (mode == OutputMode::Overlay) {
+        // 4K MODE: Detach from Qt window, render as overlay.
+        // VLC creates its own window; we force it to fullscreen.
 #ifdef Q_OS_WIN
-    const char *args[] = {
-        "--no-xlib",              // No X11 threading issues (harmless on Windows)
-        "--no-video-title-show",  // Don't overlay filename on video
-        "--quiet",                // Reduce VLC noise
-        "--no-audio",             // Digital signage typically muted
-    };
-#else
-    // Linux / Raspberry Pi Arguments
-    const char *args[] = {
-        "--no-osd",
-        "--drop-late-frames",
-        
-        // Hardware decode, but translate the pixels for X11 compatibility
-        // Fixes "get_buffer() failed" / "video output creation failed" on Pi X11
-        "--avcodec-hw=v4l2m2m-copy", 
-        
-        // Tell VLC to route the video through the X11 server (since we are in X11)
-        "--vout=xcb_x11",            
-        
-        // Force the X11 window to cover the entire TV (for the 4K overlay case)
-        "--fullscreen",              
-        
-        // Ensure it renders above your Qt UI
-        "--video-on-top",
-        
-        "--no-video-title-show",
-        "--verbose=2",            // Keep verbose logging for debugging
-        "--no-audio",
-        "--no-xlib"               // Crucial: Tell VLC not to interact with the X11 desktop directly in a way that conflicts with Qt
-    };
+        libvlc_media_player_set_hwnd(player, nullptr);
+#elif defined(Q_OS_LINUX)
+        libvlc_media_player_set_xwindow(player, 0);
 #endif
-
-    m_vlcInstance = libvlc_new(sizeof(args) / sizeof(args[0]), args);
-    if (!m_vlcInstance) {
-        qCritical() << "[ZonePlayer]" << m_zoneName << "FATAL: Failed to create libVLC instance";
-        emit errorOccurred("Failed to create libVLC instance");
-        return;
+        libvlc_set_fullscreen(player, 1);
+    } else if (m_sceneGraphOutput) {
+        // SCENE GRAPH MODE: Decode into reusable frame buffers for VideoSurfaceItem
+        auto sink = QSharedPointer<VideoFrameSink>::create();
+        sink->attach(player);
+        m_frameSinks.insert(player, sink);
+    } else {
+        // STANDARD MODE: Embed in Qt window, fullscreen OFF so it fits
+        libvlc_set_fullscreen(player, 0);
+        attachVideoWindow(player, window);
     }
 
-    // Register Log Callback
-    libvlc_log_set(m_vlcInstance, vlcLogCallback, this);
+    // Let VLC auto-fit within the child window, preserving source aspect ratio.
+    // scale=0 means "best fit" (letterbox to preserve aspect ratio).
+    // aspect=nullptr means "use source aspect ratio".
+    libvlc_video_set_scale(player, 0);
+    libvlc_video_set_aspect_ratio(player, nullptr);
 
-    m_vlcPlayer = libvlc_media_player_new(m_vlcInstance);
-    if (!m_vlcPlayer) {
-        qCritical() << "[ZonePlayer]" << m_zoneName << "FATAL: Failed to create libVLC media player";
-        emit errorOccurred("Failed to create libVLC media player");
+    qDebug() << "[ZonePlayer]" << m_zoneName << "Created"
+             << (mode == OutputMode::Overlay ? "overlay" : "embedded") << "player";
+    return player;
+}
+
+void ZonePlayer::releasePooledPlayer(libvlc_media_player_t *&player)
+{
+    if (!player)
         return;
-    }
 
-    // Register for end-of-media events
-    m_vlcEvents = libvlc_media_player_event_manager(m_vlcPlayer);
-    if (m_vlcEvents) {
-        libvlc_event_attach(m_vlcEvents, libvlc_MediaPlayerEndReached,
-                            vlcEventCallback, this);
-        libvlc_event_attach(m_vlcEvents, libvlc_MediaPlayerEncounteredError,
-                            vlcEventCallback, this);
-        libvlc_event_attach(m_vlcEvents, libvlc_MediaPlayerPlaying,
-                            vlcEventCallback, this);
+    if (player == m_vlcPlayer) {
+        m_vlcPlayer = nullptr;
+        m_vlcEvents = nullptr;
+        setActiveFrameSink(nullptr);
     }
+    libvlc_media_player_stop(player);
+    m_vlc->releasePlayer(player);
 
-    qInfo() << "[ZonePlayer]" << m_zoneName << "libVLC initialized with logging";
+    // No more callbacks after release; a surface may still hold the last frame
+    m_frameSinks.remove(player);
+    player = nullptr;
 }
 
-void ZonePlayer::releaseVlc()
+void ZonePlayer::releaseModePlayers(OutputMode mode)
 {
-    if (m_vlcPlayer) {
-        libvlc_media_player_stop(m_vlcPlayer);
-        libvlc_media_player_release(m_vlcPlayer);
-        m_vlcPlayer = nullptr;
-    }
-    if (m_vlcInstance) {
-        libvlc_release(m_vlcInstance);
-        m_vlcInstance = nullptr;
-    }
+    releasePooledPlayer(mode == OutputMode::Overlay ? m_overlayPlayer : m_embeddedPlayer);
+}
+
+void ZonePlayer::setActiveFrameSink(libvlc_media_player_t *player)
+{
+    const QSharedPointer<VideoFrameSink> sink = player ? m_frameSinks.value(player)
+                                                       : QSharedPointer<VideoFrameSink>();
+    if (sink == m_activeSink)
+        return;
+
+    m_activeSink = sink;
+    emit activeFrameSinkChanged();
 }
 
 // ──────────────────────────────────────────────
@@ -173,17 +217,45 @@ void ZonePlayer::vlcEventCallback(const libvlc_event_t *event, void *userData)
     auto *self = static_cast<ZonePlayer *>(userData);
     if (!self) return;
 
+    // Active and standby players share this callback; the source pointer is
+    // compared on the Qt thread, once the swap state can be read safely.
+    auto *source = static_cast<libvlc_media_player_t *>(event->p_obj);
+
     switch (event->type) {
     case libvlc_MediaPlayerEndReached:
         // Use queued invocation so we're on the Qt thread
-        QMetaObject::invokeMethod(self, "onMediaEndReached", Qt::QueuedConnection);
+        QMetaObject::invokeMethod(self, [self, source]() {
+            if (source == self->m_vlcPlayer)
+                self->onMediaEndReached();
+        }, Qt::QueuedConnection);
         break;
     case libvlc_MediaPlayerEncounteredError:
         qWarning() << "[ZonePlayer]" << self->m_zoneName << "VLC playback error";
-        QMetaObject::invokeMethod(self, "onMediaEndReached", Qt::QueuedConnection);
+        QMetaObject::invokeMethod(self, [self, source]() {
+            if (source == self->m_vlcPlayer) {
+                self->onMediaFailed();
+            } else if (source == self->m_standbyPlayer) {
+                // Pre-roll failed: count it and drop it; the item is either
+                // skipped while backing off or gets a regular start later
+                const int row = self->indexOfPath(self->m_standbyPath);
+                if (row >= 0)
+                    MediaQuarantine::instance()->recordFailure(self->m_playlist.at(row));
+                self->parkStandby();
+            }
+        }, Qt::QueuedConnection);
         break;
     case libvlc_MediaPlayerPlaying:
-        QMetaObject::invokeMethod(self, "checkVideoResolution", Qt::QueuedConnection);
+        QMetaObject::invokeMethod(self, [self, source]() {
+            if (source != self->m_vlcPlayer) return;
+            // Also emitted on unpause: the clock keeps running for the same file
+            if (self->m_successPath != self->m_currentMediaPath || !self->m_successTimer.isActive()) {
+                self->m_successPath = self->m_currentMediaPath;
+                self->m_successTimer.start();
+            }
+            self->checkVideoResolution();
+            self->prerollNext();
+            self->prefetchNextItem();
+        }, Qt::QueuedConnection);
         break;
     default:
         break;
@@ -201,6 +273,9 @@ bool    ZonePlayer::is4K() const               { return m_is4K; }
 QString ZonePlayer::currentMediaPath() const   { return m_currentMediaPath; }
 int     ZonePlayer::currentIndex() const       { return m_currentIndex; }
 int     ZonePlayer::playlistSize() const       { return m_playlist.size(); }
+bool    ZonePlayer::occluded() const           { return m_occluded; }
+
+QSharedPointer<VideoFrameSink> ZonePlayer::activeFrameSink() const { return m_activeSink; }
 
 // ──────────────────────────────────────────────
 // Configuration
@@ -213,9 +288,14 @@ void ZonePlayer::setImageDuration(int ms)
 
 void ZonePlayer::setGeometry(int x, int y, int w, int h)
 {
+    const QSize oldSize = m_geometry.size();
     m_geometry = QRect(x, y, w, h);
     qDebug() << "[ZonePlayer]" << m_zoneName << "Geometry set to" << m_geometry;
     createZoneWindow();
+
+    // Another size may call for another rendition
+    if (m_geometry.size() != oldSize && !m_sourcePlaylist.isEmpty())
+        applyPlaylist(selectRenditions(m_sourcePlaylist));
 }
 
 void ZonePlayer::setWindowId(quintptr winId)
@@ -228,19 +308,102 @@ void ZonePlayer::setWindowId(quintptr winId)
 void ZonePlayer::setZOrder(int z)
 {
     m_zOrder = z;
-    if (m_zoneWindow) {
-        if (z <= 0)
-            m_zoneWindow->lower();
-        else
-            m_zoneWindow->raise();
-    }
+    applyZOrder(m_zoneWindow);
     qDebug() << "[ZonePlayer]" << m_zoneName << "Z-order set to" << z;
 }
 
+void ZonePlayer::setPrerollEnabled(bool enabled)
+{
+    m_prerollEnabled = enabled;
+    if (!enabled)
+        releaseStandby();
+    qDebug() << "[ZonePlayer]" << m_zoneName << "Pre-roll" << (enabled ? "enabled" : "disabled");
+}
+
+void ZonePlayer::setRetryInterval(int ms)
+{
+    m_retryIntervalMs = qMax(100, ms);
+}
+
+void ZonePlayer::setOcclusionPolicy(const QString &policy)
+{
+    if (policy == QLatin1String("none"))
+        m_occlusionPolicy = OcclusionPolicy::None;
+    else if (policy == QLatin1String("release"))
+        m_occlusionPolicy = OcclusionPolicy::Release;
+    else
+        m_occlusionPolicy = OcclusionPolicy::Pause;
+    qDebug() << "[ZonePlayer]" << m_zoneName << "Occlusion policy:" << policy;
+}
+
+void ZonePlayer::setVlcOptions(const QStringList &options)
+{
+    m_vlcOptions = options;
+    qDebug() << "[ZonePlayer]" << m_zoneName << "Per-zone VLC options:" << m_vlcOptions;
+}
+
+void ZonePlayer::setRenderMode(const QString &mode)
+{
+    const bool sceneGraph = (mode.compare(QLatin1String("scenegraph"), Qt::CaseInsensitive) == 0);
+    if (sceneGraph == m_sceneGraphOutput)
+        return;
+
+    // Embedded players are bound to their output when created: rebuild them
+    stop();
+    releaseStandby();
+    releaseModePlayers(OutputMode::Embedded);
+    m_sceneGraphOutput = sceneGraph;
+
+    if (m_sceneGraphOutput) {
+        destroyZoneWindow();
+        destroyStandbyWindow();
+    } else {
+        createZoneWindow();
+    }
+
+    if (m_vlc)
+        m_embeddedPlayer = createPooledPlayer(OutputMode::Embedded, m_zoneWindow);
+    if (m_outputMode == OutputMode::Embedded) {
+        m_vlcPlayer = m_embeddedPlayer;
+        m_vlcEvents = m_vlcPlayer ? libvlc_media_player_event_manager(m_vlcPlayer) : nullptr;
+    }
+
+    qInfo() << "[ZonePlayer]" << m_zoneName << "Render mode:"
+            << (m_sceneGraphOutput ? "scenegraph" : "native");
+}
+
+QStringList ZonePlayer::mediaOptions(bool hardwareDecode) const
+{
+    // Hardware-accelerated decoding hints (unless DecodeBudget downgraded
+    // the start), then per-zone overrides
+    QStringList options = {
+        hardwareDecode ? QStringLiteral(":avcodec-hw=any") : QStringLiteral(":avcodec-hw=none"),
+        QStringLiteral(":no-video-title-show"),
+    };
+    for (const QString &option : m_vlcOptions)
+        options << (option.startsWith(QLatin1Char(':')) ? option : QLatin1Char(':') + option);
+    return options;
+}
+
+QString ZonePlayer::standbyLease() const
+{
+    return m_zoneName + QStringLiteral("/standby");
+}
+
+void ZonePlayer::applyZOrder(QWindow *window)
+{
+    if (!window) return;
+    if (m_zOrder <= 0)
+        window->lower();
+    else
+        window->raise();
+}
+
 void ZonePlayer::createZoneWindow()
 {
-    // Need both parent window ID and valid geometry
-    if (!m_windowId || !m_geometry.isValid())
+    // Need both parent window ID and valid geometry; the scene graph
+    // render mode has no native video windows at all
+    if (m_sceneGraphOutput || !m_windowId || !m_geometry.isValid())
         return;
 
     // Get parent QWindow from WindowService
@@ -257,49 +420,65 @@ void ZonePlayer::createZoneWindow()
     // This prevents VLC black screen issues caused by destroying the HWND during playback.
     if (m_zoneWindow && m_zoneWindow->parent() == parentWindow) {
         m_zoneWindow->setGeometry(m_geometry);
-        if (m_zOrder <= 0)
-            m_zoneWindow->lower();
-        else
-            m_zoneWindow->raise();
+        applyZOrder(m_zoneWindow);
+        if (m_standbyWindow)
+            m_standbyWindow->setGeometry(m_geometry);
         return;
     }
 
-    // Tear down any existing child window
+    // Tear down any existing child windows
     destroyZoneWindow();
+    if (m_standbyWindow) {
+        releaseStandby();
+        destroyStandbyWindow();
+    }
 
     // Create a native child window positioned at the zone coordinates
-    m_zoneWindow = new QWindow();
-    m_zoneWindow->setParent(parentWindow);
-    m_zoneWindow->setGeometry(m_geometry);
-    m_zoneWindow->setFlag(Qt::FramelessWindowHint);
-    m_zoneWindow->setObjectName(m_zoneName + QStringLiteral("_vlc"));
+    m_zoneWindow = createVideoWindow(m_zoneName + QStringLiteral("_vlc"));
+    if (!m_zoneWindow) return;
+
+    // Attach the embedded player to render into this child window
+    attachVideoWindow(m_embeddedPlayer, m_zoneWindow);
+
+    qInfo() << "[ZonePlayer]" << m_zoneName
+            << "Zone window created at" << m_geometry
+            << "childWinId:" << m_zoneWindow->winId() << "z:" << m_zOrder;
+}
+
+QWindow *ZonePlayer::createVideoWindow(const QString &objectName)
+{
+    QWindow *parentWindow = WindowService::instance() ? WindowService::instance()->mainWindow() : nullptr;
+    if (!parentWindow || !m_geometry.isValid())
+        return nullptr;
+
+    auto *window = new QWindow();
+    window->setParent(parentWindow);
+    window->setGeometry(m_geometry);
+    window->setFlag(Qt::FramelessWindowHint);
+    window->setObjectName(objectName);
 
     // Force native window handle creation
-    m_zoneWindow->create();
-    m_zoneWindow->show();
+    window->create();
+    window->show();
+    applyZOrder(window);
 
-    // Apply z-ordering
-    if (m_zOrder <= 0)
-        m_zoneWindow->lower();
-    else
-        m_zoneWindow->raise();
+    // Start hidden — shown only when video is actively playing
+    window->hide();
+    return window;
+}
 
-    // Attach libVLC to render into this child window
-    quintptr childId = m_zoneWindow->winId();
-    if (m_vlcPlayer) {
+void ZonePlayer::attachVideoWindow(libvlc_media_player_t *player, QWindow *window)
+{
+    if (!player || !window) return;
+
+    quintptr childId = window->winId();
 #ifdef Q_OS_WIN
-        libvlc_media_player_set_hwnd(m_vlcPlayer, reinterpret_cast<void *>(childId));
+    libvlc_media_player_set_hwnd(player, reinterpret_cast<void *>(childId));
 #elif defined(Q_OS_LINUX)
-        libvlc_media_player_set_xwindow(m_vlcPlayer, static_cast<uint32_t>(childId));
+    libvlc_media_player_set_xwindow(player, static_cast<uint32_t>(childId));
+#else
+    Q_UNUSED(childId);
 #endif
-    }
-
-    // Start hidden — shown only when video is actively playing
-    m_zoneWindow->hide();
-
-    qInfo() << "[ZonePlayer]" << m_zoneName
-            << "Zone window created at" << m_geometry
-            << "childWinId:" << childId << "z:" << m_zOrder;
 }
 
 void ZonePlayer::destroyZoneWindow()
@@ -312,20 +491,145 @@ void ZonePlayer::destroyZoneWindow()
     }
 }
 
+void ZonePlayer::destroyStandbyWindow()
+{
+    if (m_standbyWindow) {
+        m_standbyWindow->hide();
+        m_standbyWindow->destroy();
+        delete m_standbyWindow;
+        m_standbyWindow = nullptr;
+    }
+}
+
 // ──────────────────────────────────────────────
 // Playlist Management
 // ──────────────────────────────────────────────
-void ZonePlayer::setPlaylist(const QStringList &files)
+void ZonePlayer::setPlaylist(ZonePlaylistModel *model)
 {
-    stop();
-    m_playlist = files;
-    m_currentIndex = 0;
+    setPlaylist(model ? model->items() : QList<nctv::MediaItem>());
+}
 
-    emit playlistSizeChanged();
-    emit currentIndexChanged();
+void ZonePlayer::setPlaylist(const QList<nctv::MediaItem> &items)
+{
+    m_sourcePlaylist = items;
+    applyPlaylist(selectRenditions(items));
+}
+
+// Swaps each item for the smallest rendition covering the zone. The
+// played path changes with it, so the diff below treats a newly landed
+// rendition like a replaced file: the current one finishes first.
+QList<nctv::MediaItem> ZonePlayer::selectRenditions(const QList<nctv::MediaItem> &items) const
+{
+    // Same device-pixel zone size images are decoded at
+    const QSize zone = imageTargetSize();
+    if (!zone.isValid())
+        return items;
+
+    QList<nctv::MediaItem> selected = items;
+    for (nctv::MediaItem &item : selected) {
+        // 4K content plays as a fullscreen overlay, not at zone size
+        if (item.info.is4K())
+            continue;
+
+        // Smallest first (PlaylistService); a few pixels short still counts,
+        // the layout is proportional and rounds differently
+        for (const nctv::Rendition &rendition : std::as_const(item.renditions)) {
+            if (rendition.box.width() < zone.width() * kRenditionCoverage
+                || rendition.box.height() < zone.height() * kRenditionCoverage) {
+                continue;
+            }
+            if (rendition.filePath != item.filePath) {
+                item.filePath  = rendition.filePath;
+                item.fileSize  = rendition.fileSize;
+                item.mtimeMs   = rendition.mtimeMs;
+                item.info      = rendition.info;
+                item.optimized = true;
+            }
+            break;
+        }
+    }
+    return selected;
+}
+
+void ZonePlayer::applyPlaylist(const QList<nctv::MediaItem> &items)
+{
+    if (items == m_playlist) {
+        qDebug() << "[ZonePlayer]" << m_zoneName << "Playlist unchanged";
+        return;
+    }
+
+    // Diff against the current list; only new entries need probing
+    QSet<QString> oldSet;
+    oldSet.reserve(m_playlist.size());
+    for (const nctv::MediaItem &item : std::as_const(m_playlist))
+        oldSet.insert(item.filePath);
+
+    QHash<QString, int> newRows;     // filePath → index in items
+    newRows.reserve(items.size());
+    for (int i = 0; i < items.size(); ++i)
+        newRows.insert(items.at(i).filePath, i);
+
+    QStringList unprobedVideos;
+    int added = 0;
+    for (const nctv::MediaItem &item : items) {
+        if (oldSet.contains(item.filePath)) continue;
+        ++added;
+        if (item.isVideo() && !item.info.valid)
+            unprobedVideos.append(item.filePath);
+    }
+    const int removed = int(m_playlist.size()) - (int(items.size()) - added);
+
+    const QList<nctv::MediaItem> oldPlaylist = m_playlist;
+    const int oldIndex = m_currentIndex;
+    const bool keepPlaying = m_isPlaying && !items.isEmpty();
+
+    m_playlist = items;
+
+    if (!keepPlaying) {
+        // Nothing on screen to preserve (initial load, or the zone emptied)
+        if (m_isPlaying)
+            stop();
+        m_currentIndex = 0;
+    } else {
+        const int kept = newRows.value(m_currentMediaPath, -1);
+        if (kept >= 0) {
+            // Current item survives: it keeps playing, only its index moves
+            m_currentIndex = kept;
+        } else {
+            // Current item was removed: let it finish, then continue with the
+            // first following item that still exists (next() advances by one)
+            int successor = 0;
+            for (int i = 1; i <= oldPlaylist.size(); ++i) {
+                const int found = newRows.value(oldPlaylist.at((oldIndex + i) % oldPlaylist.size()).filePath, -1);
+                if (found >= 0) {
+                    successor = found;
+                    break;
+                }
+            }
+            m_currentIndex = (successor - 1 + items.size()) % items.size();
+        }
+
+        // The buffered next item may have moved or gone
+        prerollNext();
+        prefetchNextItem();
+    }
+
+    // Resolve video metadata ahead of playback
+    MediaProbeService::instance()->probeAll(unprobedVideos);
+
+    // First image is needed as soon as play() runs
+    if (!keepPlaying && !m_playlist.isEmpty() && m_playlist.first().isImage())
+        ImageDecodeService::instance()->prefetch(m_playlist.first().filePath, imageTargetSize());
+
+    if (m_playlist.size() != oldPlaylist.size())
+        emit playlistSizeChanged();
+    if (m_currentIndex != oldIndex)
+        emit currentIndexChanged();
 
     qInfo() << "[ZonePlayer]" << m_zoneName
-            << "Playlist loaded:" << m_playlist.size() << "items";
+            << "Playlist updated:" << m_playlist.size() << "items"
+            << "(+" << added << "/-" << removed << ")"
+            << (keepPlaying ? "playback kept" : "");
 }
 
 // ──────────────────────────────────────────────
@@ -337,16 +641,49 @@ void ZonePlayer::play()
         qWarning() << "[ZonePlayer]" << m_zoneName << "Cannot play: playlist is empty";
         return;
     }
+    m_retryTimer.stop();
+
+    // Covered by an overlay: start once it is visible again
+    if (m_suspended) {
+        m_retryOnResume = true;
+        return;
+    }
+
+    if (m_currentIndex < 0 || m_currentIndex >= m_playlist.size())
+        m_currentIndex = 0;
+
+    // Start from the current item, or the first playable one after it
+    const int index = nextPlayableIndex(m_currentIndex - 1);
+    if (index < 0) {
+        waitForPlayableItem();
+        return;
+    }
+    if (index != m_currentIndex) {
+        m_currentIndex = index;
+        emit currentIndexChanged();
+    }
     playCurrentItem();
 }
 
 void ZonePlayer::stop()
 {
     m_imageTimer.stop();
+    m_retryTimer.stop();
+    m_successTimer.stop();
+    m_restartOnResume  = false;
+    m_retryOnResume    = false;
+    m_imageRemainingMs = -1;
+    m_resumePositionMs = -1;
+    m_pendingProbePath.clear();
+    m_budgetTimer.stop();
+    m_budgetWaitPath.clear();
+    parkStandby();
 
     if (m_vlcPlayer) {
         libvlc_media_player_stop(m_vlcPlayer);
     }
+    setActiveFrameSink(nullptr);
+    DecodeBudget::instance()->release(m_zoneName);
 
     // Hide the native child window
     if (m_zoneWindow) {
@@ -367,7 +704,18 @@ void ZonePlayer::next()
 {
     if (m_playlist.isEmpty()) return;
 
-    m_currentIndex = (m_currentIndex + 1) % m_playlist.size();
+    // Skips items that are backing off after a failure or quarantined
+    const int nextIndex = nextPlayableIndex(m_currentIndex);
+    if (nextIndex < 0) {
+        if (m_isPlaying)
+            waitForPlayableItem();
+        return;
+    }
+
+    if (m_isPlaying && startPrerolled(nextIndex))
+        return;
+
+    m_currentIndex = nextIndex;
     emit currentIndexChanged();
 
     if (m_isPlaying) {
@@ -396,165 +744,201 @@ void ZonePlayer::playCurrentItem()
         m_currentIndex = 0;
     }
 
-    const QString &filePath = m_playlist.at(m_currentIndex);
-    m_currentMediaPath = filePath;
+    const nctv::MediaItem &item = m_playlist.at(m_currentIndex);
+    m_currentMediaPath = item.filePath;
+    m_pendingProbePath.clear();
     emit currentMediaPathChanged();
 
     qInfo() << "[ZonePlayer]" << m_zoneName
             << "Playing [" << (m_currentIndex + 1) << "/" << m_playlist.size() << "]:"
-            << filePath;
+            << item.filePath;
 
-    if (isImageFile(filePath)) {
-        showStaticImage(filePath);
-    } else if (isVideoFile(filePath)) {
-        playVideo(filePath);
+    if (item.isImage()) {
+        showStaticImage(item.filePath);
+    } else if (item.isVideo()) {
+        playVideo(item);
     } else {
-        qWarning() << "[ZonePlayer]" << m_zoneName << "Unsupported file type:" << filePath;
-        // Skip to next
-        QMetaObject::invokeMethod(this, "onMediaEndReached", Qt::QueuedConnection);
+        qWarning() << "[ZonePlayer]" << m_zoneName << "Unsupported file type:" << item.filePath;
+        // Skip to next (counted as a failure, so it cannot spin)
+        QMetaObject::invokeMethod(this, "onMediaFailed", Qt::QueuedConnection);
     }
 }
 
-void ZonePlayer::playVideo(const QString &filePath)
+void ZonePlayer::playVideo(const nctv::MediaItem &item)
 {
-    // Hide QML image layer
-    if (m_showImage) {
-        m_showImage = false;
-        emit showImageChanged();
-    }
-    m_imageTimer.stop();
+    const QString &filePath = item.filePath;
 
-    // Reset 4K status (assume not 4K until detected)
-    if (m_is4K) {
-        m_is4K = false;
-        emit is4KChanged();
+    // The overlay/embedded decision needs the resolution. If it isn't known
+    // yet, wait for the probe instead of parsing on the GUI thread — the
+    // previous frame or image stays up in the meantime.
+    if (item.info.valid) {
+        startVideo(filePath, item.info);
+        return;
     }
 
-    if (!m_vlcPlayer || !m_vlcInstance) {
-        qCritical() << "[ZonePlayer]" << m_zoneName << "VLC not initialized";
+    nctv::MediaInfo info;
+    if (MediaProbeService::instance()->cachedInfo(item, info)) {
+        startVideo(filePath, info);
         return;
     }
 
-    // ─────────────────────────────────────────────────────────────────────────
-    // PLAYER RECREATION STRATEGY
-    // To ensure 100% stability when switching between "Overlay/Zero-Copy" (4K)
-    // and "Embedded/XCB" (1080p) modes, we DESTROY and RECREATE the player
-    // instance for every video. This clears all internal vout state.
-    // ─────────────────────────────────────────────────────────────────────────
-    if (m_vlcPlayer) {
-        libvlc_media_player_stop(m_vlcPlayer);
-        libvlc_media_player_release(m_vlcPlayer);
-        m_vlcPlayer = nullptr;
+    m_pendingProbePath = filePath;
+    MediaProbeService::instance()->probe(filePath);
+    qDebug() << "[ZonePlayer]" << m_zoneName << "Waiting for probe:" << filePath;
+}
+
+void ZonePlayer::onProbeFinished(const QString &filePath, const nctv::MediaInfo &info)
+{
+    // Keep the result with the item; later loops need no lookup
+    if (info.valid) {
+        const int row = indexOfPath(filePath);
+        if (row >= 0)
+            m_playlist[row].info = info;
     }
 
-    m_vlcPlayer = libvlc_media_player_new(m_vlcInstance);
-    if (!m_vlcPlayer) {
-        qCritical() << "[ZonePlayer]" << m_zoneName << "FATAL: Failed to recreate libVLC media player";
-        emit errorOccurred("Failed to recreate libVLC player");
+    if (filePath == m_pendingProbePath) {
+        m_pendingProbePath.clear();
+        if (filePath == m_currentMediaPath)
+            startVideo(filePath, info);
         return;
     }
 
-    // Re-attach Event Callbacks (must be done on every new player instance)
-    m_vlcEvents = libvlc_media_player_event_manager(m_vlcPlayer);
-    if (m_vlcEvents) {
-        libvlc_event_attach(m_vlcEvents, libvlc_MediaPlayerEndReached,
-                            vlcEventCallback, this);
-        libvlc_event_attach(m_vlcEvents, libvlc_MediaPlayerEncounteredError,
-                            vlcEventCallback, this);
-        libvlc_event_attach(m_vlcEvents, libvlc_MediaPlayerPlaying,
-                            vlcEventCallback, this);
+    // Metadata for the upcoming item: it can be buffered now
+    const int nextIndex = nextPlayableIndex(m_currentIndex);
+    if (nextIndex >= 0 && nextIndex != m_currentIndex
+        && filePath == m_playlist.at(nextIndex).filePath) {
+        prerollNext();
     }
+}
 
-    // Create and load the media
-    libvlc_media_t *media = libvlc_media_new_path(m_vlcInstance,
-        QDir::toNativeSeparators(filePath).toUtf8().constData());
+void ZonePlayer::startVideo(const QString &filePath, const nctv::MediaInfo &info)
+{
+    // A 4K item costs the whole decoder: announce the overlay first, so the
+    // zones it covers suspend and hand back their leases before it asks.
+    // Only worth it when they do release, and when the item fits at all
+    DecodeBudget *budget = DecodeBudget::instance();
+    const bool preAnnounce = info.is4K() && !m_is4K
+                          && m_occlusionPolicy != OcclusionPolicy::None
+                          && DecodeBudget::costOf(info) <= budget->capacity();
+    if (preAnnounce) {
+        m_is4K = true;
+        emit is4KChanged();
+    }
 
-    if (!media) {
-        qCritical() << "[ZonePlayer]" << m_zoneName << "Failed to create VLC media:" << filePath;
-        emit errorOccurred("Failed to create VLC media for: " + filePath);
+    // Admission against the hardware decoder shared by all zones; a delayed
+    // start leaves the previous frame or image on screen
+    const DecodeBudget::Decision decision = budget->acquire(m_zoneName, info);
+    if (decision == DecodeBudget::Decision::Delay) {
+        // Not admitted after all: do not hold the other zones under an
+        // overlay that shows nothing new while this one waits
+        if (preAnnounce) {
+            m_is4K = false;
+            emit is4KChanged();
+        }
+        waitForDecodeBudget(filePath, info);
         return;
     }
+    m_budgetTimer.stop();
+    m_budgetWaitPath.clear();
 
-    // Check resolution before playing
-    unsigned width = 0, height = 0;
-    getVideoDimensions(media, width, height);
-    
-    // Determine if content is 4K (width >= 3000)
-    bool is4KContent = (width >= 3000);
+    // Hide QML image layer
+    if (m_showImage) {
+        m_showImage = false;
+        emit showImageChanged();
+    }
+    m_imageTimer.stop();
+
+    if (!m_vlc) {
+        qCritical() << "[ZonePlayer]" << m_zoneName << "VLC not initialized";
+        budget->release(m_zoneName);
+        return;
+    }
+
+    // Resolution comes from the probe (width >= 3000 → 4K)
+    const bool is4KContent = info.is4K();
     if (m_is4K != is4KContent) {
         m_is4K = is4KContent;
         emit is4KChanged();
     }
-    
-    qInfo() << "[ZonePlayer]" << m_zoneName << "Video resolution:" << width << "x" << height 
+
+    qInfo() << "[ZonePlayer]" << m_zoneName << "Video resolution:" << info.width << "x" << info.height
             << (is4KContent ? "[4K - Overlay Mode]" : "[Standard - Embedded Mode]");
 
-    if (is4KContent) {
-        // 4K MODE: Detach from Qt window, render as overlay
-        // We do NOT call createZoneWindow() or set HWND.
-        // VLC will create its own window. We force it to fullscreen.
-        
+    // ─────────────────────────────────────────────────────────────────────────
+    // MODE-AWARE PLAYER POOL
+    // Switching between "Overlay/Zero-Copy" (4K) and "Embedded/XCB" (1080p)
+    // needs clean vout state, so the players of the mode being left are
+    // destroyed and recreated on the way back. Within one mode the pooled
+    // player is reused: only the media changes.
+    // ─────────────────────────────────────────────────────────────────────────
+    const OutputMode mode = is4KContent ? OutputMode::Overlay : OutputMode::Embedded;
+    if (mode != m_outputMode) {
+        qInfo() << "[ZonePlayer]" << m_zoneName << "Output mode change, recreating players";
+        if (m_outputMode == OutputMode::Embedded)
+            releaseStandby();
+        releaseModePlayers(m_outputMode);
+        m_outputMode = mode;
+    }
+
+    if (mode == OutputMode::Overlay) {
         // Hide the embedded window if it exists (so it doesn't block the overlay)
         if (m_zoneWindow) {
             m_zoneWindow->hide();
         }
-        
-        // Ensure no HWND is set (detach if previously attached)
-#ifdef Q_OS_WIN
-        libvlc_media_player_set_hwnd(m_vlcPlayer, nullptr);
-#elif defined(Q_OS_LINUX)
-        libvlc_media_player_set_xwindow(m_vlcPlayer, 0);
-#endif
-        
-        // Force fullscreen
-        libvlc_set_fullscreen(m_vlcPlayer, 1);
-        
+        if (!m_overlayPlayer)
+            m_overlayPlayer = createPooledPlayer(OutputMode::Overlay, nullptr);
+        m_vlcPlayer = m_overlayPlayer;
     } else {
-        // STANDARD MODE: Embed in Qt window
-        // Ensure fullscreen is OFF (so it fits in the window)
-        libvlc_set_fullscreen(m_vlcPlayer, 0);
-
         // Show the native child window for VLC rendering
-        createZoneWindow(); 
-        
-        if (m_zoneWindow) {
-            // FORCE re-attachment of the window handle to VLC
-            // This is necessary because if we came from 4K mode, we detached it.
-            // createZoneWindow() skips attachment if reusing an existing window.
-            quintptr winId = m_zoneWindow->winId();
-#ifdef Q_OS_WIN
-            libvlc_media_player_set_hwnd(m_vlcPlayer, reinterpret_cast<void *>(winId));
-#elif defined(Q_OS_LINUX)
-            libvlc_media_player_set_xwindow(m_vlcPlayer, static_cast<uint32_t>(winId));
-#endif
+        createZoneWindow();
+        if (!m_embeddedPlayer)
+            m_embeddedPlayer = createPooledPlayer(OutputMode::Embedded, m_zoneWindow);
+        m_vlcPlayer = m_embeddedPlayer;
 
+        if (m_zoneWindow) {
             m_zoneWindow->show();
-            if (m_zOrder <= 0)
-                m_zoneWindow->lower();
-            else
-                m_zoneWindow->raise();
+            applyZOrder(m_zoneWindow);
         }
     }
 
-    // Hardware-accelerated decoding hints
-    libvlc_media_add_option(media, ":avcodec-hw=any");
-    libvlc_media_add_option(media, ":no-video-title-show");
+    if (!m_vlcPlayer) {
+        qCritical() << "[ZonePlayer]" << m_zoneName << "FATAL: Failed to create libVLC media player";
+        emit errorOccurred("Failed to create libVLC player");
+        budget->release(m_zoneName);
+        return;
+    }
+    m_vlcEvents = libvlc_media_player_event_manager(m_vlcPlayer);
+    setActiveFrameSink(m_vlcPlayer);
+
+    // Create and load the media (resuming a released item at its position)
+    QStringList options = mediaOptions(decision == DecodeBudget::Decision::Hardware);
+    if (m_resumePositionMs > 0 && filePath == m_currentMediaPath) {
+        options << QStringLiteral(":start-time=%1").arg(m_resumePositionMs / 1000.0, 0, 'f', 3);
+        qInfo() << "[ZonePlayer]" << m_zoneName << "Resuming at" << m_resumePositionMs << "ms";
+    }
+    m_resumePositionMs = -1;
+
+    libvlc_media_t *media = m_vlc->createMedia(filePath, options);
+
+    // Failures here are the item's: counted and backed off like a playback
+    // error (queued, so a run of failing items cannot recurse)
+    if (!media) {
+        qCritical() << "[ZonePlayer]" << m_zoneName << "Failed to create VLC media:" << filePath;
+        budget->release(m_zoneName);
+        QMetaObject::invokeMethod(this, "onMediaFailed", Qt::QueuedConnection);
+        return;
+    }
 
     libvlc_media_player_set_media(m_vlcPlayer, media);
     libvlc_media_release(media);
 
-    // Let VLC auto-fit within the child window, preserving source aspect ratio.
-    // scale=0 means "best fit" (letterbox to preserve aspect ratio).
-    // aspect=nullptr means "use source aspect ratio".
-    libvlc_video_set_scale(m_vlcPlayer, 0);
-    libvlc_video_set_aspect_ratio(m_vlcPlayer, nullptr);
-
     if (libvlc_media_player_play(m_vlcPlayer) == 0) {
         m_isPlaying = true;
         emit isPlayingChanged();
     } else {
         qCritical() << "[ZonePlayer]" << m_zoneName << "VLC play() failed for:" << filePath;
-        emit errorOccurred("VLC play() failed for: " + filePath);
+        budget->release(m_zoneName);
+        QMetaObject::invokeMethod(this, "onMediaFailed", Qt::QueuedConnection);
     }
 }
 
@@ -569,12 +953,14 @@ void ZonePlayer::showStaticImage(const QString &filePath)
 
         libvlc_media_player_stop(m_vlcPlayer);
     }
+    setActiveFrameSink(nullptr);
+    DecodeBudget::instance()->release(m_zoneName);
     if (m_zoneWindow) {
         m_zoneWindow->hide();
     }
 
-    // Set image source for QML Image component
-    m_currentImageSrc = QUrl::fromLocalFile(filePath).toString();
+    // Set image source for QML Image component (decoded at zone size)
+    m_currentImageSrc = ImageDecodeService::providerUrl(filePath, imageTargetSize());
     emit currentImageSourceChanged();
 
     // Show the QML image layer
@@ -589,6 +975,209 @@ void ZonePlayer::showStaticImage(const QString &filePath)
 
     qDebug() << "[ZonePlayer]" << m_zoneName
              << "Showing image for" << m_imageDurationMs << "ms:" << filePath;
+
+    // Use the display time to buffer a following video or image
+    prerollNext();
+    prefetchNextItem();
+}
+
+QSize ZonePlayer::imageTargetSize() const
+{
+    // Device pixels of the zone; invalid until QML reports the geometry
+    if (!m_geometry.isValid())
+        return QSize();
+    return m_geometry.size() * qGuiApp->devicePixelRatio();
+}
+
+void ZonePlayer::prefetchNextItem()
+{
+    const int nextIndex = nextPlayableIndex(m_currentIndex);
+    if (nextIndex < 0 || nextIndex == m_currentIndex)
+        return;
+
+    // Images are decoded ahead at zone size; videos get their head (or the
+    // whole file, when small) pulled from the card into the page cache
+    const nctv::MediaItem &nextItem = m_playlist.at(nextIndex);
+    if (nextItem.isImage())
+        ImageDecodeService::instance()->prefetch(nextItem.filePath, imageTargetSize());
+    else if (nextItem.isVideo())
+        ReadaheadService::instance()->prefetch(nextItem.filePath, nextItem.fileSize);
+}
+
+// ──────────────────────────────────────────────
+// Gapless Pre-roll
+// ──────────────────────────────────────────────
+// While the current item plays, the next video is opened in a standby
+// player rendering into its own hidden child window. ":start-paused" makes
+// VLC demux, decode and hold the first frame, so on end-of-media the swap
+// is just show-window + unpause instead of create/parse/open. The two
+// embedded players trade places on every swap and are otherwise reused.
+void ZonePlayer::prerollNext()
+{
+    // A suspended zone holds no extra decoder; resume pre-rolls again
+    if (!m_prerollEnabled || !m_vlc || m_suspended || m_playlist.size() < 2)
+        return;
+
+    const int nextIndex = nextPlayableIndex(m_currentIndex);
+    if (nextIndex < 0 || nextIndex == m_currentIndex) {
+        parkStandby();
+        return;
+    }
+    const nctv::MediaItem &nextItem = m_playlist.at(nextIndex);
+    const QString &nextPath = nextItem.filePath;
+
+    // Already buffered
+    if (m_standbyPlayer && m_standbyIndex == nextIndex && m_standbyPath == nextPath)
+        return;
+
+    parkStandby();
+
+    if (!nextItem.isVideo())
+        return;
+
+    // Needs the probed size first, from the item or the caches (never a
+    // parse or stat here); onProbeFinished() calls back in when it lands
+    nctv::MediaInfo info = nextItem.info;
+    if (!info.valid && !MediaProbeService::instance()->cachedInfo(nextItem, info)) {
+        MediaProbeService::instance()->probe(nextPath);
+        return;
+    }
+
+    // 4K content renders as a fullscreen overlay, which cannot be staged
+    // behind the zone window — it keeps the regular start-up path.
+    if (info.is4K())
+        return;
+
+    // Buffering ahead is optional: only with hardware capacity to spare
+    if (DecodeBudget::instance()->acquire(standbyLease(), info) != DecodeBudget::Decision::Hardware) {
+        DecodeBudget::instance()->release(standbyLease());
+        return;
+    }
+
+    // The native path stages the frame in a hidden child window; the scene
+    // graph path holds it in the standby player's frame sink
+    if (!m_sceneGraphOutput) {
+        if (!m_standbyWindow)
+            m_standbyWindow = createVideoWindow(m_zoneName + QStringLiteral("_vlc_standby"));
+        if (!m_standbyWindow) {
+            DecodeBudget::instance()->release(standbyLease());
+            return;
+        }
+    }
+
+    // Open, buffer and decode the first frame, then hold
+    QStringList options = mediaOptions();
+    options << QStringLiteral(":start-paused");
+
+    libvlc_media_t *media = m_vlc->createMedia(nextPath, options);
+    if (!media) {
+        DecodeBudget::instance()->release(standbyLease());
+        return;
+    }
+
+    // Reuse the parked player when there is one
+    if (!m_standbyPlayer)
+        m_standbyPlayer = createPooledPlayer(OutputMode::Embedded, m_standbyWindow);
+    if (!m_standbyPlayer) {
+        qWarning() << "[ZonePlayer]" << m_zoneName << "Failed to create standby player";
+        libvlc_media_release(media);
+        DecodeBudget::instance()->release(standbyLease());
+        return;
+    }
+
+    libvlc_media_player_set_media(m_standbyPlayer, media);
+    libvlc_media_release(media);
+
+    if (libvlc_media_player_play(m_standbyPlayer) != 0) {
+        qWarning() << "[ZonePlayer]" << m_zoneName << "Pre-roll failed for:" << nextPath;
+        parkStandby();
+        return;
+    }
+
+    m_standbyPath  = nextPath;
+    m_standbyIndex = nextIndex;
+
+    qDebug() << "[ZonePlayer]" << m_zoneName << "Pre-rolling [" << (nextIndex + 1) << "]:" << nextPath;
+}
+
+bool ZonePlayer::startPrerolled(int index)
+{
+    if (!m_standbyPlayer || index != m_standbyIndex
+        || index < 0 || index >= m_playlist.size()
+        || m_playlist.at(index).filePath != m_standbyPath) {
+        return false;
+    }
+
+    m_imageTimer.stop();
+    if (m_showImage) {
+        m_showImage = false;
+        emit showImageChanged();
+    }
+    if (m_is4K) {
+        m_is4K = false;
+        emit is4KChanged();
+    }
+
+    // Promote the standby slot; the previous embedded player and window take its place
+    const bool leavingOverlay = (m_outputMode == OutputMode::Overlay);
+    std::swap(m_embeddedPlayer, m_standbyPlayer);
+    std::swap(m_zoneWindow, m_standbyWindow);
+    m_outputMode = OutputMode::Embedded;
+    m_vlcPlayer = m_embeddedPlayer;
+    m_vlcEvents = libvlc_media_player_event_manager(m_vlcPlayer);
+    setActiveFrameSink(m_vlcPlayer);
+
+    m_currentIndex = index;
+    emit currentIndexChanged();
+    m_currentMediaPath = m_standbyPath;
+    emit currentMediaPathChanged();
+
+    // The standby decoder's lease now covers the zone's active stream
+    m_budgetTimer.stop();
+    m_budgetWaitPath.clear();
+    DecodeBudget::instance()->transfer(standbyLease(), m_zoneName);
+
+    // Show the buffered first frame, then resume decoding
+    if (m_zoneWindow) {
+        m_zoneWindow->show();
+        applyZOrder(m_zoneWindow);
+    }
+    libvlc_media_player_set_pause(m_vlcPlayer, 0);
+
+    // Retire the previous output only once the new one is on screen: an
+    // overlay player is destroyed (mode change), an embedded one is parked
+    if (leavingOverlay)
+        releaseModePlayers(OutputMode::Overlay);
+    parkStandby();
+
+    if (!m_isPlaying) {
+        m_isPlaying = true;
+        emit isPlayingChanged();
+    }
+
+    qInfo() << "[ZonePlayer]" << m_zoneName
+            << "Playing [" << (m_currentIndex + 1) << "/" << m_playlist.size() << "] (pre-rolled):"
+            << m_currentMediaPath;
+    return true;
+}
+
+void ZonePlayer::parkStandby()
+{
+    // Keep the player (and its window binding) for the next pre-roll
+    if (m_standbyPlayer)
+        libvlc_media_player_stop(m_standbyPlayer);
+    if (m_standbyWindow)
+        m_standbyWindow->hide();
+    DecodeBudget::instance()->release(standbyLease());
+
+    m_standbyPath.clear();
+    m_standbyIndex = -1;
+}
+
+void ZonePlayer::releaseStandby()
+{
+    parkStandby();
+    releasePooledPlayer(m_standbyPlayer);
 }
 
 // ──────────────────────────────────────────────
@@ -601,9 +1190,210 @@ void ZonePlayer::onImageTimerTimeout()
     next();
 }
 
+void ZonePlayer::onMediaFailed()
+{
+    qWarning() << "[ZonePlayer]" << m_zoneName << "Failed to play:" << m_currentMediaPath;
+    m_successTimer.stop();
+
+    const int row = indexOfPath(m_currentMediaPath);
+    if (row >= 0)
+        MediaQuarantine::instance()->recordFailure(m_playlist.at(row));
+    emit errorOccurred(QStringLiteral("Cannot play ") + m_currentMediaPath);
+
+    // next() skips the item while it backs off, and idles if nothing is left
+    next();
+}
+
+// ──────────────────────────────────────────────
+// Occlusion
+// ──────────────────────────────────────────────
+// Bound in QML to the main zone's 4K state: the fullscreen overlay covers
+// the other zones, so their decoders only compete with the 4K decode.
+void ZonePlayer::setOccluded(bool occluded)
+{
+    if (m_occluded == occluded)
+        return;
+    m_occluded = occluded;
+    emit occludedChanged();
+
+    if (occluded && m_occlusionPolicy != OcclusionPolicy::None)
+        suspendForOcclusion();
+    else if (!occluded && m_suspended)
+        resumeFromOcclusion();
+}
+
+void ZonePlayer::suspendForOcclusion()
+{
+    m_suspended = true;
+
+    if (m_retryTimer.isActive()) {
+        m_retryTimer.stop();
+        m_retryOnResume = true;
+    }
+    if (!m_isPlaying)
+        return;
+
+    // Hold the image where it is
+    if (m_imageTimer.isActive()) {
+        m_imageRemainingMs = m_imageTimer.remainingTime();
+        m_imageTimer.stop();
+    }
+
+    // A video still waiting on its probe or on decode capacity is started
+    // on resume instead
+    if (!m_pendingProbePath.isEmpty() || !m_budgetWaitPath.isEmpty()) {
+        m_pendingProbePath.clear();
+        m_budgetTimer.stop();
+        m_budgetWaitPath.clear();
+        m_restartOnResume = true;
+    }
+
+    // The standby decoder is rebuilt by prerollNext() on resume
+    parkStandby();
+
+    if (m_vlcPlayer && !m_showImage && !m_restartOnResume) {
+        if (m_occlusionPolicy == OcclusionPolicy::Release) {
+            m_resumePositionMs = libvlc_media_player_get_time(m_vlcPlayer);
+            libvlc_media_player_stop(m_vlcPlayer);
+            setActiveFrameSink(nullptr);
+            DecodeBudget::instance()->release(m_zoneName);
+            m_restartOnResume = true;
+        } else {
+            // Paused, the stream decodes nothing: its share goes to the overlay
+            libvlc_media_player_set_pause(m_vlcPlayer, 1);
+            DecodeBudget::instance()->release(m_zoneName);
+        }
+        if (m_zoneWindow)
+            m_zoneWindow->hide();
+    }
+
+    qInfo() << "[ZonePlayer]" << m_zoneName << "Occluded, playback suspended"
+            << (m_occlusionPolicy == OcclusionPolicy::Release ? "(decoder released)" : "(paused)");
+}
+
+void ZonePlayer::resumeFromOcclusion()
+{
+    m_suspended = false;
+
+    // Idle zones (waiting to retry, or asked to play while covered) start now
+    if (m_retryOnResume) {
+        m_retryOnResume = false;
+        play();
+        return;
+    }
+    if (!m_isPlaying)
+        return;
+
+    qInfo() << "[ZonePlayer]" << m_zoneName << "Visible again, resuming playback";
+
+    if (m_restartOnResume) {
+        m_restartOnResume = false;
+        const int row = indexOfPath(m_currentMediaPath);
+        if (row < 0) {
+            // Removed by a rescan meanwhile: continue with what follows it
+            m_resumePositionMs = -1;
+            next();
+            return;
+        }
+        if (row != m_currentIndex) {
+            m_currentIndex = row;
+            emit currentIndexChanged();
+        }
+        playCurrentItem();
+    } else if (m_showImage) {
+        m_imageTimer.start(qMax(0, m_imageRemainingMs));
+    } else if (m_vlcPlayer) {
+        // The lease was handed back while paused
+        const int row = indexOfPath(m_currentMediaPath);
+        const nctv::MediaInfo info = row >= 0 ? m_playlist.at(row).info : nctv::MediaInfo();
+        if (DecodeBudget::instance()->acquire(m_zoneName, info) == DecodeBudget::Decision::Delay) {
+            // Capacity went elsewhere meanwhile: wait for it like any start,
+            // then continue from here
+            m_resumePositionMs = libvlc_media_player_get_time(m_vlcPlayer);
+            libvlc_media_player_stop(m_vlcPlayer);
+            setActiveFrameSink(nullptr);
+            startVideo(m_currentMediaPath, info);
+        } else {
+            if (m_outputMode == OutputMode::Embedded && m_zoneWindow) {
+                m_zoneWindow->show();
+                applyZOrder(m_zoneWindow);
+            }
+            libvlc_media_player_set_pause(m_vlcPlayer, 0);
+        }
+    }
+    m_imageRemainingMs = -1;
+
+    prerollNext();
+    prefetchNextItem();
+}
+
+void ZonePlayer::onRetryTimerTimeout()
+{
+    if (m_playlist.isEmpty())
+        return;
+
+    qDebug() << "[ZonePlayer]" << m_zoneName << "Retrying playback...";
+    play();
+}
+
+void ZonePlayer::waitForPlayableItem()
+{
+    // Every item is failing or quarantined: stop instead of spinning through
+    // create/parse/fail, and look again after retryIntervalMs
+    qWarning() << "[ZonePlayer]" << m_zoneName << "No playable item; retrying in"
+               << m_retryIntervalMs << "ms";
+    stop();
+    m_retryTimer.start(m_retryIntervalMs);
+}
+
+// ──────────────────────────────────────────────
+// Decode Budget
+// ──────────────────────────────────────────────
+void ZonePlayer::waitForDecodeBudget(const QString &filePath, const nctv::MediaInfo &info)
+{
+    if (filePath != m_budgetWaitPath) {
+        m_budgetWaitPath = filePath;
+        m_budgetWaitInfo = info;
+        m_budgetWaitClock.start();
+        qInfo() << "[ZonePlayer]" << m_zoneName << "Waiting for decode capacity:" << filePath;
+    } else if (m_budgetWaitClock.elapsed() > kMaxDecodeWaitMs) {
+        // Another zone holds the decoder for good (e.g. a looping 4K item):
+        // move on rather than freeze on this one
+        const int index = nextPlayableIndex(m_currentIndex);
+        if (index >= 0 && index != m_currentIndex) {
+            qWarning() << "[ZonePlayer]" << m_zoneName << "No decode capacity after"
+                       << kMaxDecodeWaitMs << "ms, skipping:" << filePath;
+            m_budgetWaitPath.clear();
+            m_currentIndex = index;
+            emit currentIndexChanged();
+            playCurrentItem();
+            return;
+        }
+    }
+    m_budgetTimer.start(m_retryIntervalMs);
+}
+
+void ZonePlayer::onDecodeBudgetRetry()
+{
+    if (m_budgetWaitPath.isEmpty() || m_suspended)
+        return;
+
+    // The wait is stale once the zone has moved to another item
+    if (m_budgetWaitPath != m_currentMediaPath) {
+        m_budgetTimer.stop();
+        m_budgetWaitPath.clear();
+        return;
+    }
+
+    const QString filePath = m_budgetWaitPath;
+    startVideo(filePath, m_budgetWaitInfo);
+}
+
 void ZonePlayer::onMediaEndReached()
 {
     qDebug() << "[ZonePlayer]" << m_zoneName << "Media end reached, advancing...";
+    m_successTimer.stop();
+    MediaQuarantine::instance()->recordSuccess(m_currentMediaPath);
     emit mediaFinished();
 
     // Advance to next item (loops via modulo in next())
@@ -630,61 +1420,26 @@ void ZonePlayer::checkVideoResolution()
 }
 
 // ──────────────────────────────────────────────
-// File Type Detection
+// Playlist Lookup
 // ──────────────────────────────────────────────
-bool ZonePlayer::isImageFile(const QString &filePath) const
-{
-    const QString ext = QFileInfo(filePath).suffix().toLower();
-    return s_imageExtensions.contains(ext);
-}
-
-bool ZonePlayer::isVideoFile(const QString &filePath) const
+int ZonePlayer::indexOfPath(const QString &filePath) const
 {
-    const QString ext = QFileInfo(filePath).suffix().toLower();
-    return s_videoExtensions.contains(ext);
+    for (int i = 0; i < m_playlist.size(); ++i) {
+        if (m_playlist.at(i).filePath == filePath)
+            return i;
+    }
+    return -1;
 }
 
-void ZonePlayer::getVideoDimensions(libvlc_media_t *media, unsigned &width, unsigned &height)
+int ZonePlayer::nextPlayableIndex(int after) const
 {
-    width = 0;
-    height = 0;
-    if (!media) return;
-
-    // Use libvlc_media_parse_with_options instead of deprecated libvlc_media_parse
-    // libvlc_media_parse_local: Parse local files (fast)
-    // Timeout: 1000ms (should be instant for local files)
-    int status = libvlc_media_parse_with_options(media, libvlc_media_parse_local, 1000);
-    if (status == -1) {
-        qWarning() << "[ZonePlayer]" << m_zoneName << "Failed to trigger media parsing";
-        return;
-    }
-
-    // Wait for parsing to complete (synchronous wait for local files)
-    // In libVLC 3.0+, parsing is async. We block briefly to ensure dimensions are ready.
-    for (int i = 0; i < 50; ++i) { // Wait up to ~500ms
-        libvlc_media_parsed_status_t parsedStatus = libvlc_media_get_parsed_status(media);
-        if (parsedStatus == libvlc_media_parsed_status_done) {
-            break;
-        }
-        if (parsedStatus == libvlc_media_parsed_status_failed || 
-            parsedStatus == libvlc_media_parsed_status_timeout) {
-            qWarning() << "[ZonePlayer]" << m_zoneName << "Media parsing failed or timed out";
-            return;
-        }
-        QThread::msleep(10);
-    }
-
-    libvlc_media_track_t **tracks = nullptr;
-    unsigned trackCount = libvlc_media_tracks_get(media, &tracks);
-
-    if (trackCount > 0) {
-        for (unsigned i = 0; i < trackCount; ++i) {
-            if (tracks[i]->i_type == libvlc_track_video) {
-                width = tracks[i]->video->i_width;
-                height = tracks[i]->video->i_height;
-                break; // Found primary video track
-            }
-        }
-        libvlc_media_tracks_release(tracks, trackCount);
+    // Wraps around; may return `after` itself when it is the only playable item
+    const int count = int(m_playlist.size());
+    const MediaQuarantine *quarantine = MediaQuarantine::instance();
+    for (int i = 1; i <= count; ++i) {
+        const int index = ((after + i) % count + count) % count;
+        if (quarantine->isPlayable(m_playlist.at(index)))
+            return index;
     }
+    return -1;
 }
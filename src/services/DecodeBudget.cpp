@@ -0,0 +1,139 @@
+#include "services/DecodeBudget.h"
+
+#include <QGuiApplication>
+#include <QDebug>
+
+DecodeBudget *DecodeBudget::s_instance = nullptr;
+
+// Reference stream for one cost unit
+static constexpr double kUnitPixelRate = 1920.0 * 1080.0 * 30.0;
+static constexpr double kDefaultFps    = 30.0;
+
+// ──────────────────────────────────────────────
+// Constructor / Singleton
+// ──────────────────────────────────────────────
+DecodeBudget::DecodeBudget(QObject *parent)
+    : QObject(parent)
+{
+}
+
+DecodeBudget *DecodeBudget::instance()
+{
+    if (!s_instance) {
+        s_instance = new DecodeBudget(qApp);
+    }
+    return s_instance;
+}
+
+void DecodeBudget::setCapacity(double capacity, double softwareMaxCost)
+{
+    m_capacity        = qMax(0.0, capacity);
+    m_softwareMaxCost = qMax(0.0, softwareMaxCost);
+    qInfo() << "[DecodeBudget] Hardware decode capacity:" << m_capacity
+            << "units | software fallback up to:" << m_softwareMaxCost;
+    emit loadChanged();
+}
+
+// ──────────────────────────────────────────────
+// Cost Model
+// ──────────────────────────────────────────────
+double DecodeBudget::costOf(const nctv::MediaInfo &info)
+{
+    // Unprobed (codec unknown too): assume a full 1080p30 stream rather than nothing
+    if (!info.valid)
+        return 1.0;
+
+    // Only these reach the hardware decoder (H.264 via V4L2 M2M, HEVC stateless)
+    const QString codec = info.codec.toLower();
+    const bool hardware = codec == QLatin1String("h264") || codec == QLatin1String("avc1")
+                       || codec == QLatin1String("hevc") || codec == QLatin1String("h265");
+    if (!hardware)
+        return 0.0;
+
+    // Probed without a resolution: same assumption
+    if (info.width == 0 || info.height == 0)
+        return 1.0;
+
+    const double fps = info.frameRate > 0.0 ? info.frameRate : kDefaultFps;
+    return double(info.width) * double(info.height) * fps / kUnitPixelRate;
+}
+
+// ──────────────────────────────────────────────
+// Leases
+// ──────────────────────────────────────────────
+DecodeBudget::Decision DecodeBudget::acquire(const QString &owner, const nctv::MediaInfo &info)
+{
+    // The owner's previous stream is being replaced
+    release(owner);
+
+    const double cost = costOf(info);
+    if (cost <= 0.0)
+        return Decision::Hardware;
+
+    if (m_load + cost <= m_capacity + 1e-6) {
+        m_leases.insert(owner, cost);
+        m_load += cost;
+        emit loadChanged();
+        qDebug() << "[DecodeBudget]" << owner << "admitted:" << cost
+                 << "| load" << m_load << "/" << m_capacity;
+        return Decision::Hardware;
+    }
+
+    if (cost <= m_softwareMaxCost) {
+        qInfo() << "[DecodeBudget]" << owner << "over budget (" << m_load << "+" << cost
+                << "/" << m_capacity << "), decoding in software";
+        return Decision::Software;
+    }
+
+    qInfo() << "[DecodeBudget]" << owner << "over budget (" << m_load << "+" << cost
+            << "/" << m_capacity << "), delaying start";
+    return Decision::Delay;
+}
+
+void DecodeBudget::release(const QString &owner)
+{
+    const auto it = m_leases.find(owner);
+    if (it == m_leases.end())
+        return;
+
+    m_load = qMax(0.0, m_load - it.value());
+    m_leases.erase(it);
+    if (m_leases.isEmpty())
+        m_load = 0.0;   // No drift from repeated float arithmetic
+
+    emit loadChanged();
+    notifyCapacityFreed();
+}
+
+void DecodeBudget::notifyCapacityFreed()
+{
+    // Queued and coalesced: waiting zones retry once the releasing zone has
+    // finished its own state change, not from inside it
+    if (m_notifyPending)
+        return;
+    m_notifyPending = true;
+    QMetaObject::invokeMethod(this, [this]() {
+        m_notifyPending = false;
+        emit capacityFreed();
+    }, Qt::QueuedConnection);
+}
+
+void DecodeBudget::transfer(const QString &from, const QString &to)
+{
+    // The new owner's previous stream ends either way, even when the
+    // incoming one took no budget (codec without hardware decoding)
+    release(to);
+
+    const auto it = m_leases.find(from);
+    if (it == m_leases.end())
+        return;
+
+    const double cost = it.value();
+    m_leases.erase(it);
+    m_leases.insert(to, cost);
+    m_load += cost;
+    emit loadChanged();
+}
+
+double DecodeBudget::load() const     { return m_load; }
+double DecodeBudget::capacity() const { return m_capacity; }
@@ -0,0 +1,157 @@
+#include "services/ImageDecodeService.h"
+#include "core/MediaCache.h"
+
+#include <QGuiApplication>
+#include <QImageReader>
+#include <QMutexLocker>
+#include <QDebug>
+
+ImageDecodeService *ImageDecodeService::s_instance = nullptr;
+
+// ──────────────────────────────────────────────
+// Constructor / Destructor
+// ──────────────────────────────────────────────
+ImageDecodeService::ImageDecodeService(QObject *parent)
+    : QObject(parent)
+{
+    // One worker: prefetches are due seconds ahead, decoding them one at a
+    // time keeps the cores free for video
+    m_pool.setMaxThreadCount(1);
+}
+
+ImageDecodeService::~ImageDecodeService()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+ImageDecodeService *ImageDecodeService::instance()
+{
+    if (!s_instance) {
+        s_instance = new ImageDecodeService(qApp);
+    }
+    return s_instance;
+}
+
+// ──────────────────────────────────────────────
+// Provider URLs
+// ──────────────────────────────────────────────
+// image://zone/<w>x<h>/<base64url path> — the path is encoded so separators,
+// '?' and '#' in file names survive the URL round trip unchanged.
+QString ImageDecodeService::providerUrl(const QString &filePath, const QSize &targetSize)
+{
+    const QByteArray encoded = filePath.toUtf8().toBase64(QByteArray::Base64UrlEncoding
+                                                          | QByteArray::OmitTrailingEquals);
+    return QStringLiteral("image://zone/%1x%2/%3")
+        .arg(qMax(0, targetSize.width()))
+        .arg(qMax(0, targetSize.height()))
+        .arg(QString::fromLatin1(encoded));
+}
+
+bool ImageDecodeService::parseProviderId(const QString &id, QString &filePath, QSize &targetSize)
+{
+    const int slash = id.indexOf(QLatin1Char('/'));
+    if (slash < 0)
+        return false;
+
+    const QStringList dims = id.left(slash).split(QLatin1Char('x'));
+    if (dims.size() != 2)
+        return false;
+    targetSize = QSize(dims.at(0).toInt(), dims.at(1).toInt());
+
+    const QByteArray encoded = id.mid(slash + 1).toLatin1();
+    filePath = QString::fromUtf8(QByteArray::fromBase64(encoded, QByteArray::Base64UrlEncoding
+                                                                 | QByteArray::OmitTrailingEquals));
+    return !filePath.isEmpty();
+}
+
+QString ImageDecodeService::cacheKey(const QString &filePath, const QSize &targetSize)
+{
+    return QStringLiteral("%1x%2|%3").arg(targetSize.width()).arg(targetSize.height()).arg(filePath);
+}
+
+// ──────────────────────────────────────────────
+// Prefetch / Lookup
+// ──────────────────────────────────────────────
+void ImageDecodeService::prefetch(const QString &filePath, const QSize &targetSize)
+{
+    const QString key = cacheKey(filePath, targetSize);
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_pending.contains(key))
+            return;
+
+        if (MediaCache::instance()->containsImage(key))
+            return;
+        m_pending.insert(key);
+    }
+
+    m_pool.start([this, key, filePath, targetSize]() {
+        const QImage image = decode(filePath, targetSize);
+        store(key, image);
+    });
+}
+
+QImage ImageDecodeService::image(const QString &filePath, const QSize &targetSize)
+{
+    const QString key = cacheKey(filePath, targetSize);
+    {
+        QMutexLocker locker(&m_mutex);
+        while (m_pending.contains(key))
+            m_decoded.wait(&m_mutex);
+
+        QImage cached;
+        if (MediaCache::instance()->lookupImage(key, cached))
+            return cached;
+    }
+
+    // Not prefetched (first item, geometry change): decode here — this is
+    // already a QML loader thread, never the GUI thread
+    qDebug() << "[ImageDecodeService] Prefetch miss:" << filePath;
+    const QImage image = decode(filePath, targetSize);
+    store(key, image);
+    return image;
+}
+
+void ImageDecodeService::store(const QString &key, const QImage &image)
+{
+    MediaCache::instance()->insertImage(key, image);
+
+    QMutexLocker locker(&m_mutex);
+    m_pending.remove(key);
+    m_decoded.wakeAll();
+}
+
+// ──────────────────────────────────────────────
+// Worker: Scaled Decode
+// ──────────────────────────────────────────────
+QImage ImageDecodeService::decode(const QString &filePath, const QSize &targetSize)
+{
+    QImageReader reader(filePath);
+    reader.setAutoTransform(true);
+
+    // Only ever scale down, preserving aspect ratio (PreserveAspectFit)
+    const QSize sourceSize = reader.size();
+    if (targetSize.isValid() && sourceSize.isValid()) {
+        // size() is pre-rotation; match the target to the stored orientation
+        QSize fitInto = targetSize;
+        if (reader.transformation() & QImageIOHandler::TransformationRotate90)
+            fitInto.transpose();
+
+        if (sourceSize.width() > fitInto.width() || sourceSize.height() > fitInto.height())
+            reader.setScaledSize(sourceSize.scaled(fitInto, Qt::KeepAspectRatio));
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "[ImageDecodeService] Failed to decode" << filePath << reader.errorString();
+        return image;
+    }
+
+    // Upload-ready format: no conversion on the render thread
+    if (image.format() != QImage::Format_ARGB32_Premultiplied && image.format() != QImage::Format_RGB32) {
+        image = image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                                              : QImage::Format_RGB32);
+    }
+    return image;
+}
@@ -0,0 +1,216 @@
+#include "services/MediaProbeService.h"
+#include "core/MediaIndex.h"
+#include "core/MediaCache.h"
+
+#include <QGuiApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QSemaphore>
+#include <QDebug>
+
+MediaProbeService *MediaProbeService::s_instance = nullptr;
+
+// Upper bound for a single parse; local files normally finish in a few ms
+static constexpr int kParseTimeoutMs = 3000;
+
+// ──────────────────────────────────────────────
+// Constructor / Destructor
+// ──────────────────────────────────────────────
+MediaProbeService::MediaProbeService(QObject *parent)
+    : QObject(parent)
+{
+    qRegisterMetaType<nctv::MediaInfo>("nctv::MediaInfo");
+
+    // Parsing is mostly I/O bound; two workers keep the SD card busy
+    // without competing with the zone decoders for CPU.
+    m_pool.setMaxThreadCount(2);
+}
+
+MediaProbeService::~MediaProbeService()
+{
+    // Workers use the libVLC runtime — drain them before dropping it
+    m_pool.clear();
+    m_pool.waitForDone();
+    m_vlc.reset();
+}
+
+MediaProbeService *MediaProbeService::instance()
+{
+    if (!s_instance) {
+        s_instance = new MediaProbeService(qApp);
+    }
+    return s_instance;
+}
+
+bool MediaProbeService::ensureVlc()
+{
+    if (m_vlc)
+        return true;
+
+    // Parse on the same libVLC instance the zones use (no second plugin bank)
+    m_vlc = VlcRuntime::acquire();
+    if (!m_vlc->isValid()) {
+        qCritical() << "[MediaProbeService] libVLC runtime unavailable";
+        m_vlc.reset();
+        return false;
+    }
+    return true;
+}
+
+// ──────────────────────────────────────────────
+// Queueing
+// ──────────────────────────────────────────────
+void MediaProbeService::probe(const QString &filePath)
+{
+    if (filePath.isEmpty() || m_pending.contains(filePath))
+        return;
+
+    nctv::MediaInfo info;
+    if (MediaCache::instance()->lookupMediaInfo(filePath, info)) {
+        QMetaObject::invokeMethod(this, [this, filePath, info]() {
+            emit probeFinished(filePath, info);
+        }, Qt::QueuedConnection);
+        return;
+    }
+
+    if (!ensureVlc()) {
+        QMetaObject::invokeMethod(this, [this, filePath]() {
+            onProbeResult(filePath, nctv::MediaInfo{});
+        }, Qt::QueuedConnection);
+        return;
+    }
+
+    m_pending.insert(filePath);
+
+    VlcRuntime *vlc = m_vlc.data();
+    m_pool.start([this, vlc, filePath]() {
+        const nctv::MediaInfo info = probeFile(vlc, filePath);
+        QMetaObject::invokeMethod(this, [this, filePath, info]() {
+            onProbeResult(filePath, info);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void MediaProbeService::probeAll(const QStringList &filePaths)
+{
+    for (const QString &path : filePaths) {
+        // Index hits are resolved by the workers, off the Qt thread
+        if (!MediaCache::instance()->containsMediaInfo(path))
+            probe(path);
+    }
+}
+
+void MediaProbeService::onProbeResult(const QString &filePath, const nctv::MediaInfo &info)
+{
+    m_pending.remove(filePath);
+    MediaCache::instance()->insertMediaInfo(filePath, info);
+
+    qDebug() << "[MediaProbeService] Probed" << filePath
+             << info.width << "x" << info.height << info.codec
+             << "profile" << info.profile << info.bitrate / 1000 << "kb/s"
+             << info.durationMs << "ms" << info.frameRate << "fps"
+             << (info.valid ? "" : "(failed)");
+
+    emit probeFinished(filePath, info);
+}
+
+// ──────────────────────────────────────────────
+// Lookup
+// ──────────────────────────────────────────────
+bool MediaProbeService::cachedInfo(const nctv::MediaItem &item, nctv::MediaInfo &info)
+{
+    if (MediaCache::instance()->lookupMediaInfo(item.filePath, info))
+        return true;
+
+    // Fall back to the persistent index, validated by what the scan listed
+    if (MediaIndex::instance()->lookup(item.filePath, item.fileSize, item.mtimeMs, info)) {
+        MediaCache::instance()->insertMediaInfo(item.filePath, info);
+        return true;
+    }
+    return false;
+}
+
+bool MediaProbeService::isPending(const QString &filePath) const
+{
+    return m_pending.contains(filePath);
+}
+
+// ──────────────────────────────────────────────
+// Worker: libVLC Parse
+// ──────────────────────────────────────────────
+static void onMediaParsed(const libvlc_event_t *event, void *userData)
+{
+    Q_UNUSED(event);
+    static_cast<QSemaphore *>(userData)->release();
+}
+
+nctv::MediaInfo MediaProbeService::probeFile(VlcRuntime *vlc, const QString &filePath)
+{
+    nctv::MediaInfo info;
+
+    // Unchanged files (same size + mtime) are answered from the index
+    const QFileInfo fi(filePath);
+    const qint64 fileSize = fi.size();
+    const qint64 mtimeMs  = fi.lastModified().toMSecsSinceEpoch();
+    if (MediaIndex::instance()->lookup(filePath, fileSize, mtimeMs, info))
+        return info;
+
+    libvlc_media_t *media = vlc->createMedia(filePath);
+    if (!media)
+        return info;
+
+    // Block this worker (never the GUI thread) until the preparser reports back
+    QSemaphore parsed;
+    libvlc_event_manager_t *events = libvlc_media_event_manager(media);
+    libvlc_event_attach(events, libvlc_MediaParsedChanged, onMediaParsed, &parsed);
+
+    if (libvlc_media_parse_with_options(media, libvlc_media_parse_local, kParseTimeoutMs) == 0)
+        parsed.tryAcquire(1, kParseTimeoutMs + 500);
+
+    libvlc_event_detach(events, libvlc_MediaParsedChanged, onMediaParsed, &parsed);
+
+    if (libvlc_media_get_parsed_status(media) == libvlc_media_parsed_status_done) {
+        info.durationMs = libvlc_media_get_duration(media);
+
+        libvlc_media_track_t **tracks = nullptr;
+        const unsigned trackCount = libvlc_media_tracks_get(media, &tracks);
+        for (unsigned i = 0; i < trackCount; ++i) {
+            if (tracks[i]->i_type != libvlc_track_video)
+                continue;
+
+            info.width  = tracks[i]->video->i_width;
+            info.height = tracks[i]->video->i_height;
+            if (tracks[i]->video->i_frame_rate_den > 0) {
+                info.frameRate = static_cast<double>(tracks[i]->video->i_frame_rate_num)
+                               / tracks[i]->video->i_frame_rate_den;
+            }
+
+            const uint32_t fourcc = tracks[i]->i_codec;
+            const char chars[4] = {
+                static_cast<char>(fourcc & 0xFF),
+                static_cast<char>((fourcc >> 8) & 0xFF),
+                static_cast<char>((fourcc >> 16) & 0xFF),
+                static_cast<char>((fourcc >> 24) & 0xFF),
+            };
+            info.codec   = QString::fromLatin1(chars, 4).trimmed();
+            info.profile = tracks[i]->i_profile;
+            info.bitrate = tracks[i]->i_bitrate;
+            break; // Found primary video track
+        }
+        if (trackCount > 0)
+            libvlc_media_tracks_release(tracks, trackCount);
+
+        // Most containers carry no stream bitrate: use the file average
+        if (info.bitrate <= 0 && info.durationMs > 0)
+            info.bitrate = fileSize * 8 * 1000 / info.durationMs;
+
+        info.valid = true;
+    }
+
+    libvlc_media_release(media);
+
+    if (info.valid)
+        MediaIndex::instance()->insert(filePath, fileSize, mtimeMs, info);
+    return info;
+}
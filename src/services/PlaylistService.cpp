@@ -1,20 +1,80 @@
 #include "services/PlaylistService.h"
+#include "services/MediaProbeService.h"
+#include "core/MediaIndex.h"
+#include "core/MediaTypes.h"
 
 #include <QDir>
 #include <QDirIterator>
 #include <QFileInfo>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QQmlEngine>
 #include <QDebug>
 #include <algorithm>
+#include <utility>
+
+const QStringList PlaylistService::s_zoneNames = {
+    "background", "main", "horizontal", "vertical"
+};
+
+// Settle time after the last filesystem event before a zone is rescanned
+static constexpr int kWatchDebounceMs = 500;
+
+// Snapshot file header
+static constexpr quint32 kSnapshotMagic   = 0x5350434E; // "NCPS"
+static constexpr quint32 kSnapshotVersion = 5;   // 2: MediaItem records, 3: profile/bitrate, 4: renditions, 5: mtimes
+
+// Coarsest directory mtime resolution to expect (FAT: 2 s). A folder
+// modified this recently may change again within the same stamp, so its
+// mtime is not trusted to skip the next walk
+static constexpr qint64 kCoarseMtimeMs = 2000;
 
 // ──────────────────────────────────────────────
-// Supported Extensions
+// Snapshot Serialization
 // ──────────────────────────────────────────────
-const QStringList PlaylistService::s_supportedExtensions = {
-    // Video
-    "mp4", "mkv", "avi", "mov", "wmv", "flv", "webm", "ts", "m4v", "mpg", "mpeg",
-    // Image
-    "jpg", "jpeg", "png", "bmp", "gif", "webp", "svg"
-};
+namespace nctv {
+
+static QDataStream &operator<<(QDataStream &out, const MediaInfo &info)
+{
+    return out << info.width << info.height << info.codec << info.profile << info.bitrate
+               << info.durationMs << info.frameRate << info.valid << info.acceptedOptimized;
+}
+
+static QDataStream &operator>>(QDataStream &in, MediaInfo &info)
+{
+    return in >> info.width >> info.height >> info.codec >> info.profile >> info.bitrate
+              >> info.durationMs >> info.frameRate >> info.valid >> info.acceptedOptimized;
+}
+
+static QDataStream &operator<<(QDataStream &out, const Rendition &rendition)
+{
+    return out << rendition.filePath << rendition.box << rendition.fileSize << rendition.mtimeMs
+               << rendition.info;
+}
+
+static QDataStream &operator>>(QDataStream &in, Rendition &rendition)
+{
+    return in >> rendition.filePath >> rendition.box >> rendition.fileSize >> rendition.mtimeMs
+              >> rendition.info;
+}
+
+static QDataStream &operator<<(QDataStream &out, const MediaItem &item)
+{
+    return out << item.filePath << qint32(item.type) << item.optimized << item.fileSize << item.mtimeMs
+               << item.info << item.renditions;
+}
+
+static QDataStream &operator>>(QDataStream &in, MediaItem &item)
+{
+    qint32 type = 0;
+    in >> item.filePath >> type >> item.optimized >> item.fileSize >> item.mtimeMs
+       >> item.info >> item.renditions;
+    item.type = MediaType(type);
+    return in;
+}
+
+} // namespace nctv
 
 // ──────────────────────────────────────────────
 // Constructor
@@ -22,6 +82,31 @@ const QStringList PlaylistService::s_supportedExtensions = {
 PlaylistService::PlaylistService(QObject *parent)
     : QObject(parent)
 {
+    qRegisterMetaType<nctv::MediaItem>("nctv::MediaItem");
+
+    for (const QString &zone : s_zoneNames) {
+        auto *model = new ZonePlaylistModel(zone, this);
+        // Handed to QML through modelForZone(); it must not take ownership
+        QQmlEngine::setObjectOwnership(model, QQmlEngine::CppOwnership);
+        m_models.insert(zone, model);
+    }
+
+    // One walker per zone
+    m_scanPool.setMaxThreadCount(s_zoneNames.size());
+
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged,
+            this, &PlaylistService::onDirectoryChanged);
+
+    // Metadata for videos the MediaIndex did not know at scan time
+    connect(MediaProbeService::instance(), &MediaProbeService::probeFinished,
+            this, &PlaylistService::onProbeFinished);
+}
+
+PlaylistService::~PlaylistService()
+{
+    // Walkers post back to this object — let them finish first
+    m_scanPool.clear();
+    m_scanPool.waitForDone();
 }
 
 // ──────────────────────────────────────────────
@@ -38,98 +123,364 @@ void PlaylistService::setOptimizedSuffix(const QString &suffix)
     m_optimizedSuffix = suffix;
 }
 
+void PlaylistService::setContentSniffing(bool enabled)
+{
+    m_sniffContent = enabled;
+}
+
+void PlaylistService::setSnapshotPath(const QString &path)
+{
+    m_snapshotPath = path;
+}
+
 // ──────────────────────────────────────────────
-// Full Scan
+// Snapshot
 // ──────────────────────────────────────────────
-void PlaylistService::scanAll()
+bool PlaylistService::loadSnapshot()
 {
-    m_isScanning = true;
-    emit isScanningChanged();
+    if (m_snapshotPath.isEmpty())
+        return false;
+
+    QFile file(m_snapshotPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qInfo() << "[PlaylistService] No playlist snapshot yet:" << m_snapshotPath;
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0, version = 0;
+    QString root, suffix;
+    QHash<QString, MediaItems> lists;
+    QHash<QString, DirMtimes>  mtimes;
+    in >> magic >> version;
+    if (in.status() != QDataStream::Ok || magic != kSnapshotMagic || version != kSnapshotVersion) {
+        qWarning() << "[PlaylistService] Ignoring unreadable playlist snapshot:" << m_snapshotPath;
+        return false;
+    }
 
+    in >> root >> suffix >> lists >> mtimes;
+    if (in.status() != QDataStream::Ok) {
+        qWarning() << "[PlaylistService] Ignoring truncated playlist snapshot:" << m_snapshotPath;
+        return false;
+    }
+    if (root != m_playlistRoot || suffix != m_optimizedSuffix) {
+        qInfo() << "[PlaylistService] Playlist snapshot is for another configuration, ignoring";
+        return false;
+    }
+
+    for (const QString &zone : s_zoneNames) {
+        m_models.value(zone)->setItems(lists.value(zone));
+        m_zoneDirMtimes.insert(zone, mtimes.value(zone));
+        indexMedia(lists.value(zone));
+    }
+
+    qInfo() << "[PlaylistService] Restored playlist snapshot:" << totalFileCount() << "files"
+            << "| BG:" << m_models.value("background")->count()
+            << "| Main:" << m_models.value("main")->count()
+            << "| Horiz:" << m_models.value("horizontal")->count()
+            << "| Vert:" << m_models.value("vertical")->count();
+
+    emit playlistsChanged();
+    for (const QString &zone : s_zoneNames) {
+        if (!filesForZone(zone).isEmpty())
+            emit zonePlaylistChanged(zone);
+    }
+    return true;
+}
+
+void PlaylistService::saveSnapshot()
+{
+    if (m_snapshotPath.isEmpty())
+        return;
+
+    QHash<QString, MediaItems> lists;
+    for (const QString &zone : s_zoneNames)
+        lists.insert(zone, m_models.value(zone)->items());
+
+    QDir().mkpath(QFileInfo(m_snapshotPath).absolutePath());
+
+    QSaveFile file(m_snapshotPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[PlaylistService] Cannot write playlist snapshot:" << file.errorString();
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << kSnapshotMagic << kSnapshotVersion << m_playlistRoot << m_optimizedSuffix
+        << lists << m_zoneDirMtimes;
+
+    if (!file.commit()) {
+        qWarning() << "[PlaylistService] Failed to commit playlist snapshot:" << file.errorString();
+        return;
+    }
+
+    m_snapshotDirty = false;
+    qDebug() << "[PlaylistService] Playlist snapshot saved:" << m_snapshotPath;
+}
+
+// ──────────────────────────────────────────────
+// Asynchronous Scanning
+// ──────────────────────────────────────────────
+// Each zone is walked on its own pool thread and published the moment it
+// is done, so the UI (and zones with small folders) start while a large
+// folder on a slow SD card is still being read. Every request bumps the
+// zone's generation; results of superseded scans are dropped.
+void PlaylistService::scanAll()
+{
     qInfo() << "[PlaylistService] Scanning all playlists from:" << m_playlistRoot;
 
-    m_backgroundFiles = resolveOptimizedFiles(
-        scanDirectory(m_playlistRoot + QStringLiteral("/playlist-background")));
+    for (const QString &zone : s_zoneNames)
+        startZoneScan(zone);
+}
+
+void PlaylistService::scanZone(const QString &zoneName)
+{
+    if (!m_models.contains(zoneName)) {
+        qWarning() << "[PlaylistService] Unknown zone:" << zoneName;
+        return;
+    }
+
+    qInfo() << "[PlaylistService] Scanning zone:" << zoneName;
+    startZoneScan(zoneName);
+}
+
+void PlaylistService::startZoneScan(const QString &zoneName)
+{
+    const quint64 generation = ++m_zoneGenerations[zoneName];
+
+    if (m_activeScans++ == 0) {
+        m_scanTimer.start();
+        m_isScanning = true;
+        emit isScanningChanged();
+    }
+
+    // Workers get copies only; they never touch the service's state
+    const QString     dirPath    = zoneDirectory(zoneName);
+    const QString     suffix     = m_optimizedSuffix;
+    const bool        sniff      = m_sniffContent;
+    const MediaItems  knownItems = m_models.value(zoneName)->items();
+    const DirMtimes   knownDirs  = m_zoneDirMtimes.value(zoneName);
+
+    m_scanPool.start([this, zoneName, generation, dirPath, suffix, sniff, knownItems, knownDirs]() {
+        MediaItems items;
+        DirMtimes  dirMtimes;
+
+        // Same folder mtimes as the last scan: no entry was added, removed
+        // or renamed. A file rewritten in place does not touch its folder,
+        // so the listed files are stat'ed too — skip only the walk
+        if (dirsUnchanged(knownDirs) && itemsUnchanged(knownItems)) {
+            items     = knownItems;
+            dirMtimes = knownDirs;
+        } else {
+            items = resolveOptimizedFiles(scanDirectory(dirPath, sniff, &dirMtimes, knownItems), suffix);
+        }
+
+        QMetaObject::invokeMethod(this, [this, zoneName, generation, items, dirMtimes]() {
+            onZoneScanned(zoneName, generation, items, dirMtimes);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void PlaylistService::onZoneScanned(const QString &zoneName, quint64 generation,
+                                    const MediaItems &items, const DirMtimes &dirMtimes)
+{
+    const bool current = (generation == m_zoneGenerations.value(zoneName));
+
+    if (current && m_zoneDirMtimes.value(zoneName) != dirMtimes) {
+        m_zoneDirMtimes.insert(zoneName, dirMtimes);
+        m_snapshotDirty = true;
+    }
 
-    m_mainFiles = resolveOptimizedFiles(
-        scanDirectory(m_playlistRoot + QStringLiteral("/playlist-main")));
+    // New subfolders need their own watch
+    if (current && m_watching)
+        watchZone(zoneName);
 
-    m_horizontalFiles = resolveOptimizedFiles(
-        scanDirectory(m_playlistRoot + QStringLiteral("/playlist-horizontal")));
+    if (!current) {
+        qDebug() << "[PlaylistService] Dropping superseded scan of zone:" << zoneName;
+    } else if (!m_models.value(zoneName)->setItems(items)) {
+        qDebug() << "[PlaylistService] Zone unchanged:" << zoneName;
+    } else {
+        m_snapshotDirty = true;
+        indexMedia(items);
+        emit playlistsChanged();
+        emit zonePlaylistChanged(zoneName);
+    }
 
-    m_verticalFiles = resolveOptimizedFiles(
-        scanDirectory(m_playlistRoot + QStringLiteral("/playlist-vertical")));
+    if (--m_activeScans > 0)
+        return;
 
     const int total = totalFileCount();
 
-    qInfo() << "[PlaylistService] Scan complete. Total files:" << total
-            << "| BG:" << m_backgroundFiles.size()
-            << "| Main:" << m_mainFiles.size()
-            << "| Horiz:" << m_horizontalFiles.size()
-            << "| Vert:" << m_verticalFiles.size();
+    qInfo() << "[PlaylistService] Scan complete in" << m_scanTimer.elapsed() << "ms. Total files:" << total
+            << "| BG:" << m_models.value("background")->count()
+            << "| Main:" << m_models.value("main")->count()
+            << "| Horiz:" << m_models.value("horizontal")->count()
+            << "| Vert:" << m_models.value("vertical")->count();
+
+    if (m_snapshotDirty)
+        saveSnapshot();
 
     m_isScanning = false;
     emit isScanningChanged();
-    emit playlistsChanged();
     emit scanComplete(total);
 }
 
-void PlaylistService::scanZone(const QString &zoneName)
+// ──────────────────────────────────────────────
+// Filesystem Watching
+// ──────────────────────────────────────────────
+void PlaylistService::startWatching()
 {
-    qInfo() << "[PlaylistService] Scanning zone:" << zoneName;
+    if (m_watching)
+        return;
+    m_watching = true;
 
-    if (zoneName == "background") {
-        m_backgroundFiles = resolveOptimizedFiles(
-            scanDirectory(m_playlistRoot + QStringLiteral("/playlist-background")));
-    } else if (zoneName == "main") {
-        m_mainFiles = resolveOptimizedFiles(
-            scanDirectory(m_playlistRoot + QStringLiteral("/playlist-main")));
-    } else if (zoneName == "horizontal") {
-        m_horizontalFiles = resolveOptimizedFiles(
-            scanDirectory(m_playlistRoot + QStringLiteral("/playlist-horizontal")));
-    } else if (zoneName == "vertical") {
-        m_verticalFiles = resolveOptimizedFiles(
-            scanDirectory(m_playlistRoot + QStringLiteral("/playlist-vertical")));
-    } else {
-        qWarning() << "[PlaylistService] Unknown zone:" << zoneName;
+    for (const QString &zone : s_zoneNames) {
+        auto *timer = new QTimer(this);
+        timer->setSingleShot(true);
+        timer->setInterval(kWatchDebounceMs);
+        connect(timer, &QTimer::timeout, this, [this, zone]() { scanZone(zone); });
+        m_debounceTimers.insert(zone, timer);
+
+        watchZone(zone);
+    }
+
+    // The root catches zone folders that are created later
+    if (QFileInfo::exists(m_playlistRoot))
+        m_watcher.addPath(m_playlistRoot);
+
+    qInfo() << "[PlaylistService] Watching" << m_watcher.directories().size()
+            << "directories under" << m_playlistRoot;
+}
+
+void PlaylistService::stopWatching()
+{
+    if (!m_watching)
         return;
+    m_watching = false;
+
+    const QStringList dirs = m_watcher.directories();
+    if (!dirs.isEmpty())
+        m_watcher.removePaths(dirs);
+
+    qDeleteAll(m_debounceTimers);
+    m_debounceTimers.clear();
+}
+
+void PlaylistService::watchZone(const QString &zoneName)
+{
+    // inotify watches are not recursive: add the zone folder and every
+    // subfolder. The scan walker already listed them (folder mtimes), so the
+    // GUI thread never walks the tree; before the first scan only the zone
+    // folder is known, and its completion adds the rest
+    QStringList dirs = m_zoneDirMtimes.value(zoneName).keys();
+    if (dirs.isEmpty()) {
+        const QString root = zoneDirectory(zoneName);
+        if (!QFileInfo(root).isDir())
+            return;
+        dirs.append(root);
     }
 
-    emit playlistsChanged();
+    const QStringList watched = m_watcher.directories();
+    QStringList missing;
+    for (const QString &dir : dirs) {
+        if (!watched.contains(dir))
+            missing.append(dir);
+    }
+    if (!missing.isEmpty())
+        m_watcher.addPaths(missing);
+}
+
+void PlaylistService::onDirectoryChanged(const QString &path)
+{
+    const QString changed = QDir::cleanPath(path);
+
+    // Root changed: a zone folder may have appeared or vanished
+    if (changed == QDir::cleanPath(m_playlistRoot)) {
+        for (QTimer *timer : std::as_const(m_debounceTimers))
+            timer->start();
+        return;
+    }
+
+    for (auto it = m_debounceTimers.constBegin(); it != m_debounceTimers.constEnd(); ++it) {
+        const QString zoneDir = QDir::cleanPath(zoneDirectory(it.key()));
+        if (changed == zoneDir || changed.startsWith(zoneDir + QLatin1Char('/'))) {
+            // Restart: a burst of copies results in one rescan
+            it.value()->start();
+            return;
+        }
+    }
 }
 
 // ──────────────────────────────────────────────
 // Accessors
 // ──────────────────────────────────────────────
-QStringList PlaylistService::backgroundFiles() const  { return m_backgroundFiles; }
-QStringList PlaylistService::mainFiles() const        { return m_mainFiles; }
-QStringList PlaylistService::horizontalFiles() const  { return m_horizontalFiles; }
-QStringList PlaylistService::verticalFiles() const    { return m_verticalFiles; }
+QStringList PlaylistService::backgroundFiles() const  { return filesForZone("background"); }
+QStringList PlaylistService::mainFiles() const        { return filesForZone("main"); }
+QStringList PlaylistService::horizontalFiles() const  { return filesForZone("horizontal"); }
+QStringList PlaylistService::verticalFiles() const    { return filesForZone("vertical"); }
 bool        PlaylistService::isScanning() const       { return m_isScanning; }
 
+QString PlaylistService::zoneDirectory(const QString &zoneName) const
+{
+    return m_playlistRoot + QStringLiteral("/playlist-") + zoneName;
+}
+
+ZonePlaylistModel *PlaylistService::modelForZone(const QString &zoneName) const
+{
+    return m_models.value(zoneName, nullptr);
+}
+
 QStringList PlaylistService::filesForZone(const QString &zoneName) const
 {
-    if (zoneName == "background")  return m_backgroundFiles;
-    if (zoneName == "main")        return m_mainFiles;
-    if (zoneName == "horizontal")  return m_horizontalFiles;
-    if (zoneName == "vertical")    return m_verticalFiles;
-    return {};
+    const ZonePlaylistModel *model = modelForZone(zoneName);
+    return model ? model->filePaths() : QStringList();
 }
 
 int PlaylistService::totalFileCount() const
 {
-    return m_backgroundFiles.size()
-         + m_mainFiles.size()
-         + m_horizontalFiles.size()
-         + m_verticalFiles.size();
+    int total = 0;
+    for (const ZonePlaylistModel *model : m_models)
+        total += model->count();
+    return total;
 }
 
 // ──────────────────────────────────────────────
 // Directory Scanning
 // ──────────────────────────────────────────────
-QStringList PlaylistService::scanDirectory(const QString &dirPath) const
+PlaylistService::MediaItems PlaylistService::scanDirectory(const QString &dirPath, bool sniffContent,
+                                                           DirMtimes *dirMtimes,
+                                                           const MediaItems &knownItems)
 {
-    QStringList result;
+    MediaItems result;
+
+    // Sniffing opens every file: the previous scan's verdicts are reused
+    // for files whose size and mtime have not changed
+    struct KnownType {
+        qint64          fileSize;
+        qint64          mtimeMs;
+        nctv::MediaType type;
+    };
+    QHash<QString, KnownType> knownTypes;
+    if (sniffContent) {
+        for (const nctv::MediaItem &item : knownItems) {
+            knownTypes.insert(item.filePath, {item.fileSize, item.mtimeMs, item.type});
+            for (const nctv::Rendition &rendition : item.renditions) {
+                knownTypes.insert(rendition.filePath,
+                                  {rendition.fileSize, rendition.mtimeMs, nctv::MediaType::Video});
+            }
+        }
+    }
+
+    // Folder mtimes too fresh to rule out a same-stamp change are recorded
+    // as unknown, so the next scan walks again
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const auto trustedMtime = [now](const QFileInfo &fi) {
+        const qint64 mtime = fi.lastModified().toMSecsSinceEpoch();
+        return now - mtime < kCoarseMtimeMs ? qint64(-1) : mtime;
+    };
 
     QDir dir(dirPath);
     if (!dir.exists()) {
@@ -137,25 +488,112 @@ QStringList PlaylistService::scanDirectory(const QString &dirPath) const
         return result;
     }
 
-    QDirIterator it(dirPath, QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    if (dirMtimes)
+        dirMtimes->insert(dirPath, trustedMtime(QFileInfo(dirPath)));
+
+    QDirIterator it(dirPath, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
     while (it.hasNext()) {
         it.next();
         const QFileInfo fi = it.fileInfo();
-        if (isSupportedExtension(fi.suffix().toLower())) {
-            result.append(fi.absoluteFilePath());
+        if (fi.isDir()) {
+            if (dirMtimes)
+                dirMtimes->insert(fi.absoluteFilePath(), trustedMtime(fi));
+            continue;
         }
-    }
 
-    // Sort alphabetically for deterministic playlist order
-    std::sort(result.begin(), result.end());
+        const qint64 mtimeMs = fi.lastModified().toMSecsSinceEpoch();
+        const auto known = knownTypes.constFind(fi.absoluteFilePath());
+        const bool unchanged = known != knownTypes.cend() && known->fileSize == fi.size()
+                            && known->mtimeMs == mtimeMs;
+        const nctv::MediaType type = unchanged ? known->type
+                                               : nctv::MediaTypes::classify(fi.absoluteFilePath(), fi.suffix(), sniffContent);
+        if (type == nctv::MediaType::Unknown)
+            continue;
+
+        // Classify once here, on the walker thread, from the stat the
+        // iterator already did; the player never looks at the path again
+        nctv::MediaItem item;
+        item.filePath = fi.absoluteFilePath();
+        item.type     = type;
+        item.fileSize = fi.size();
+        item.mtimeMs  = mtimeMs;
+        if (type == nctv::MediaType::Video)
+            MediaIndex::instance()->lookup(item.filePath, item.fileSize, item.mtimeMs, item.info);
+        result.append(item);
+    }
 
     qDebug() << "[PlaylistService] Scanned" << dirPath << "→" << result.size() << "files";
     return result;
 }
 
-bool PlaylistService::isSupportedExtension(const QString &ext) const
+bool PlaylistService::dirsUnchanged(const DirMtimes &dirMtimes)
+{
+    if (dirMtimes.isEmpty())
+        return false;
+
+    for (auto it = dirMtimes.constBegin(); it != dirMtimes.constEnd(); ++it) {
+        const QFileInfo fi(it.key());
+        if (!fi.isDir() || fi.lastModified().toMSecsSinceEpoch() != it.value())
+            return false;
+    }
+    return true;
+}
+
+bool PlaylistService::itemsUnchanged(const MediaItems &items)
+{
+    const auto unchanged = [](const QString &filePath, qint64 fileSize, qint64 mtimeMs) {
+        const QFileInfo fi(filePath);
+        return fi.exists() && fi.size() == fileSize && fi.lastModified().toMSecsSinceEpoch() == mtimeMs;
+    };
+
+    for (const nctv::MediaItem &item : items) {
+        if (!unchanged(item.filePath, item.fileSize, item.mtimeMs))
+            return false;
+        for (const nctv::Rendition &rendition : item.renditions) {
+            if (!unchanged(rendition.filePath, rendition.fileSize, rendition.mtimeMs))
+                return false;
+        }
+    }
+    return true;
+}
+
+// ──────────────────────────────────────────────
+// Metadata Indexing
+// ──────────────────────────────────────────────
+// Queue every video the scan could not answer from the MediaIndex; results
+// are merged into the zone models by onProbeFinished().
+void PlaylistService::indexMedia(const MediaItems &items) const
+{
+    QStringList videos;
+    for (const nctv::MediaItem &item : items) {
+        if (item.isVideo() && !item.info.valid)
+            videos.append(item.filePath);
+    }
+    MediaProbeService::instance()->probeAll(videos);
+}
+
+void PlaylistService::onProbeFinished(const QString &filePath, const nctv::MediaInfo &info)
 {
-    return s_supportedExtensions.contains(ext);
+    if (!info.valid)
+        return;
+
+    for (ZonePlaylistModel *model : std::as_const(m_models)) {
+        const int row = model->indexOf(filePath);
+        if (row >= 0 && !model->items().at(row).info.valid) {
+            model->updateInfo(filePath, info);
+            m_snapshotDirty = true;
+        }
+    }
+}
+
+void PlaylistService::markAccepted(const QString &filePath, const nctv::MediaInfo &info)
+{
+    for (ZonePlaylistModel *model : std::as_const(m_models)) {
+        if (model->indexOf(filePath) >= 0) {
+            model->updateInfo(filePath, info);
+            m_snapshotDirty = true;
+        }
+    }
 }
 
 // ──────────────────────────────────────────────
@@ -163,41 +601,75 @@ bool PlaylistService::isSupportedExtension(const QString &ext) const
 // ──────────────────────────────────────────────
 // For each file, if an optimized version exists (e.g., video_optimized.mp4),
 // prefer it over the raw version. Skip raw files that have optimized twins.
-QStringList PlaylistService::resolveOptimizedFiles(const QStringList &rawFiles) const
+// Zone-sized encodes (video_optimized_448x849.mp4) are not listed on their
+// own: they ride along as renditions of the item, for ZonePlayer to pick.
+//
+// rawFiles is the complete directory listing from scanDirectory(), so the
+// twin is looked up in the listing itself: one pass over the paths, keyed
+// on "<dir>/<base>" as views into rawFiles — no stat, no string building.
+PlaylistService::MediaItems PlaylistService::resolveOptimizedFiles(const MediaItems &rawFiles,
+                                                                   const QString &optimizedSuffix)
 {
-    QMap<QString, QString> bestFiles; // baseName → absolutePath
+    // Which file stands for the item: a full-frame encode beats the raw
+    // file, which beats a rendition standing in for a deleted source
+    enum Rank : quint8 { RenditionOnly, Raw, FullFrame };
 
-    for (const QString &filePath : rawFiles) {
-        QFileInfo fi(filePath);
-        QString baseName = fi.completeBaseName();
-        const QString ext = fi.suffix();
-        const QString dir = fi.absolutePath();
+    MediaItems result;
+    result.reserve(rawFiles.size());
+    QList<Rank> ranks;
+    ranks.reserve(rawFiles.size());
+    QHash<QStringView, qsizetype> slots; // "<dir>/<base>" → index in result
+    slots.reserve(rawFiles.size());
 
-        // Check if this IS an optimized file
-        const bool isOptimized = baseName.endsWith(m_optimizedSuffix);
+    for (const nctv::MediaItem &raw : rawFiles) {
+        // Paths are absolute with '/' separators (QFileInfo::absoluteFilePath)
+        const QString &filePath = raw.filePath;
+        const qsizetype slash = filePath.lastIndexOf(QLatin1Char('/'));
+        const qsizetype dot   = filePath.lastIndexOf(QLatin1Char('.'));
+        const QStringView stem = QStringView(filePath).left(dot > slash ? dot : filePath.size());
 
-        if (isOptimized) {
-            // Remove the suffix to get the original base name
-            const QString originalBase = baseName.left(baseName.length() - m_optimizedSuffix.length());
-            const QString key = dir + "/" + originalBase;
-            // Optimized always wins
-            bestFiles[key] = filePath;
-        } else {
-            const QString key = dir + "/" + baseName;
-            // Only insert raw if no optimized version already found
-            if (!bestFiles.contains(key)) {
-                // Check if an optimized version exists on disk
-                const QString optimizedPath = dir + "/" + baseName + m_optimizedSuffix + "." + ext;
-                if (QFileInfo::exists(optimizedPath)) {
-                    bestFiles[key] = optimizedPath;
-                } else {
-                    bestFiles[key] = filePath;
-                }
-            }
+        // Check if this IS an optimized file (full-frame or zone-sized)
+        QStringView key = stem;
+        QSize box;
+        const bool isOptimized = nctv::parseOptimizedStem(stem, optimizedSuffix, &key, &box);
+        const Rank rank = !isOptimized ? Raw : box.isValid() ? RenditionOnly : FullFrame;
+
+        // Files the optimizer accepted as-is count as optimized too
+        nctv::MediaItem item = raw;
+        item.optimized = isOptimized || raw.info.acceptedOptimized;
+        if (rank == RenditionOnly)
+            item.renditions.append({filePath, box, raw.fileSize, raw.mtimeMs, raw.info});
+
+        const auto it = slots.constFind(key);
+        if (it == slots.cend()) {
+            slots.insert(key, result.size());
+            result.append(item);
+            ranks.append(rank);
+        } else if (rank == RenditionOnly) {
+            result[it.value()].renditions.append(item.renditions.constFirst());
+        } else if (rank > ranks.at(it.value())) {
+            // Optimized always wins, whichever of the pair was listed first
+            item.renditions = std::move(result[it.value()].renditions);
+            result[it.value()] = std::move(item);
+            ranks[it.value()] = rank;
         }
     }
 
-    QStringList result = bestFiles.values();
-    std::sort(result.begin(), result.end());
+    // Smallest rendition first, as ZonePlayer searches them
+    for (nctv::MediaItem &item : result) {
+        if (item.renditions.size() > 1) {
+            std::sort(item.renditions.begin(), item.renditions.end(),
+                      [](const nctv::Rendition &a, const nctv::Rendition &b) {
+                const qint64 areaA = qint64(a.box.width()) * a.box.height();
+                const qint64 areaB = qint64(b.box.width()) * b.box.height();
+                return areaA != areaB ? areaA < areaB : a.filePath < b.filePath;
+            });
+        }
+    }
+
+    // Sort alphabetically for deterministic playlist order
+    std::sort(result.begin(), result.end(), [](const nctv::MediaItem &a, const nctv::MediaItem &b) {
+        return a.filePath < b.filePath;
+    });
     return result;
 }
@@ -0,0 +1,141 @@
+#include "services/ReadaheadService.h"
+
+#include <QGuiApplication>
+#include <QMutexLocker>
+#include <QThread>
+#include <QFile>
+#include <QDebug>
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+ReadaheadService *ReadaheadService::s_instance = nullptr;
+
+static constexpr qint64 kMegabyte   = 1024 * 1024;
+static constexpr qint64 kChunkBytes = 1 * kMegabyte;   // Pacing granularity
+
+// ──────────────────────────────────────────────
+// Constructor / Destructor
+// ──────────────────────────────────────────────
+ReadaheadService::ReadaheadService(QObject *parent)
+    : QObject(parent)
+{
+    // One worker: requests are paced one after another against the budget
+    m_pool.setMaxThreadCount(1);
+    m_clock.start();
+}
+
+ReadaheadService::~ReadaheadService()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+ReadaheadService *ReadaheadService::instance()
+{
+    if (!s_instance) {
+        s_instance = new ReadaheadService(qApp);
+    }
+    return s_instance;
+}
+
+// ──────────────────────────────────────────────
+// Configuration
+// ──────────────────────────────────────────────
+void ReadaheadService::setBudget(int budgetMBps, int headMB, int wholeFileMB)
+{
+    QMutexLocker locker(&m_mutex);
+    m_bytesPerSecond = qMax(0, budgetMBps) * kMegabyte;
+    m_headBytes      = qMax(0, headMB) * kMegabyte;
+    m_wholeFileBytes = qMax(0, wholeFileMB) * kMegabyte;
+
+    if (m_bytesPerSecond <= 0) {
+        qInfo() << "[ReadaheadService] Disabled";
+        return;
+    }
+    qInfo() << "[ReadaheadService] Budget:" << budgetMBps << "MB/s | head:" << headMB
+            << "MB | whole file up to:" << wholeFileMB << "MB";
+}
+
+// ──────────────────────────────────────────────
+// Prefetch
+// ──────────────────────────────────────────────
+void ReadaheadService::prefetch(const QString &filePath, qint64 fileSize)
+{
+#ifdef Q_OS_LINUX
+    qint64 length = 0;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_bytesPerSecond <= 0 || fileSize <= 0 || m_pending.contains(filePath))
+            return;
+
+        length = (fileSize <= m_wholeFileBytes) ? fileSize : qMin(fileSize, m_headBytes);
+        if (length <= 0)
+            return;
+        m_pending.insert(filePath);
+    }
+
+    m_pool.start([this, filePath, length]() {
+        readahead(filePath, length);
+
+        QMutexLocker locker(&m_mutex);
+        m_pending.remove(filePath);
+    });
+#else
+    Q_UNUSED(filePath);
+    Q_UNUSED(fileSize);
+#endif
+}
+
+// ──────────────────────────────────────────────
+// Worker: Paced Readahead
+// ──────────────────────────────────────────────
+void ReadaheadService::readahead(const QString &filePath, qint64 length)
+{
+#ifdef Q_OS_LINUX
+    const int fd = ::open(QFile::encodeName(filePath).constData(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        qDebug() << "[ReadaheadService] Cannot open" << filePath;
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // WILLNEED queues the read in the kernel and returns; issuing it chunk
+    // by chunk at the budgeted rate bounds the extra load on the card
+    for (qint64 offset = 0; offset < length; offset += kChunkBytes) {
+        const qint64 chunk = qMin(kChunkBytes, length - offset);
+        pace(chunk);
+        if (::posix_fadvise(fd, offset, chunk, POSIX_FADV_WILLNEED) != 0)
+            break;
+    }
+    ::close(fd);
+
+    qDebug() << "[ReadaheadService] Prefetched" << length / 1024 << "KB of" << filePath
+             << "in" << timer.elapsed() << "ms";
+#else
+    Q_UNUSED(filePath);
+    Q_UNUSED(length);
+#endif
+}
+
+void ReadaheadService::pace(qint64 bytes)
+{
+    qint64 bytesPerSecond = 0;
+    {
+        QMutexLocker locker(&m_mutex);
+        bytesPerSecond = m_bytesPerSecond;
+    }
+    if (bytesPerSecond <= 0)
+        return;
+
+    // Token bucket without burst: each chunk gets the next free time slot
+    const qint64 now = m_clock.nsecsElapsed();
+    if (m_nextSlotNs > now)
+        QThread::usleep(static_cast<unsigned long>((m_nextSlotNs - now) / 1000));
+
+    m_nextSlotNs = qMax(now, m_nextSlotNs) + bytes * 1000000000LL / bytesPerSecond;
+}
@@ -1,38 +1,298 @@
 #include "utils/VideoOptimizer.h"
+#include "core/MediaIndex.h"
+#include "core/MediaCache.h"
+#include "core/MediaTypes.h"
+#include "services/MediaProbeService.h"
 
 #include <QDir>
 #include <QDirIterator>
+#include <QFile>
 #include <QFileInfo>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
 #include <QStandardPaths>
+#include <QRegularExpression>
+#include <QThread>
 #include <QDebug>
 
-// ──────────────────────────────────────────────
-// Supported Video Extensions
-// ──────────────────────────────────────────────
-const QStringList VideoOptimizer::s_videoExtensions = {
-    "mp4", "mkv", "avi", "mov", "wmv", "flv", "webm", "ts", "m4v", "mpg", "mpeg"
+#include <cmath>
+
+#include <utility>
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#include <signal.h>
+#endif
+#ifdef Q_OS_LINUX
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#ifdef Q_OS_WIN
+#include <windows.h>
+#endif
+
+#ifdef Q_OS_LINUX
+// linux/ioprio.h is not exported by every libc; the ABI values are stable
+static constexpr int kIoprioWhoProcess = 1;
+static constexpr int kIoprioClassIdle  = 3;
+static constexpr int kIoprioClassShift = 13;
+#endif
+
+// x265 gains little beyond a few threads per 1080p encode; more cores are
+// better spent on parallel jobs
+static constexpr int kThreadsPerJob = 4;
+
+// Attempts before a failing (or crashing) job is given up until its input changes
+static constexpr int kMaxAttempts = 3;
+
+// Schedule: headroom sampling period, the margin above the threshold a
+// paused encoder waits for, so a borderline load does not flap, and how long
+// it stays paused after the service's CPU quota last throttled playback
+static constexpr int kScheduleIntervalMs      = 3000;
+static constexpr int kResumeHysteresisPercent = 10;
+static constexpr int kThrottleHoldMs          = 15000;
+
+// What the Pi's HEVC decoder plays natively: files within this are kept
+static constexpr unsigned kTargetMaxWidth  = 4096;
+static constexpr unsigned kTargetMaxHeight = 2160;
+static constexpr double   kTargetMaxFps    = 60.5;
+static constexpr int      kHevcProfileMain   = 1;   // general_profile_idc
+static constexpr int      kHevcProfileMain10 = 2;
+
+namespace {
+
+// "0::/system.slice/nctv-player.service" → /sys/fs/cgroup/system.slice/nctv-player.service.
+// Read once: the service does not change cgroups while it runs
+QString cgroupDir()
+{
+    static const QString dir = []() {
+        QFile file(QStringLiteral("/proc/self/cgroup"));
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+            return QString();
+
+        while (!file.atEnd()) {
+            const QByteArray line = file.readLine().trimmed();
+            if (line.startsWith("0::"))
+                return QStringLiteral("/sys/fs/cgroup") + QString::fromUtf8(line.mid(3));
+        }
+        return QString();
+    }();
+    return dir;
+}
+
+// CPUs granted by cpu.max ("<quota> <period>"), or -1 for "max" / no cgroup
+double cgroupCpuLimit()
+{
+    const QString dir = cgroupDir();
+    if (dir.isEmpty())
+        return -1.0;
+
+    QFile file(dir + QStringLiteral("/cpu.max"));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return -1.0;
+
+    const QList<QByteArray> fields = file.readAll().trimmed().split(' ');
+    if (fields.size() != 2)
+        return -1.0;
+
+    bool quotaOk = false, periodOk = false;
+    const qint64 quota  = fields.at(0).toLongLong(&quotaOk);
+    const qint64 period = fields.at(1).toLongLong(&periodOk);
+    if (!quotaOk || !periodOk || quota <= 0 || period <= 0)
+        return -1.0;
+    return double(quota) / double(period);
+}
+
+// The machine's CPUs, capped by a cgroup limit from cgroupCpuLimit()
+double cpusWithin(double limit)
+{
+    const double cpus = QThread::idealThreadCount();
+    return limit > 0.0 ? qMin(cpus, limit) : cpus;
+}
+
+#ifdef Q_OS_LINUX
+qint64 ticksToUs(qint64 ticks)
+{
+    static const qint64 ticksPerSecond = sysconf(_SC_CLK_TCK);
+    return ticksPerSecond > 0 ? ticks * 1000000 / ticksPerSecond : -1;
+}
+
+// The service cgroup's cpu.stat: CPU time used, and how often / how long
+// the quota held the whole cgroup (playback included) back; -1 if unknown
+struct CgroupCpuStat {
+    qint64 usageUs     = -1;
+    qint64 nrThrottled = -1;
+    qint64 throttledUs = -1;
 };
 
+CgroupCpuStat cgroupCpuStat()
+{
+    CgroupCpuStat stat;
+    const QString dir = cgroupDir();
+    if (dir.isEmpty())
+        return stat;
+
+    QFile file(dir + QStringLiteral("/cpu.stat"));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return stat;
+
+    while (!file.atEnd()) {
+        const QList<QByteArray> fields = file.readLine().simplified().split(' ');
+        if (fields.size() != 2)
+            continue;
+        if (fields.at(0) == "usage_usec")
+            stat.usageUs = fields.at(1).toLongLong();
+        else if (fields.at(0) == "nr_throttled")
+            stat.nrThrottled = fields.at(1).toLongLong();
+        else if (fields.at(0) == "throttled_usec")
+            stat.throttledUs = fields.at(1).toLongLong();
+    }
+    return stat;
+}
+
+// Busy CPU time of the whole machine: "cpu user nice system idle iowait irq softirq steal ..."
+qint64 systemBusyUs()
+{
+    QFile file(QStringLiteral("/proc/stat"));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return -1;
+
+    const QList<QByteArray> fields = file.readLine().simplified().split(' ');
+    if (fields.size() < 9 || fields.at(0) != "cpu")
+        return -1;
+
+    qint64 ticks = 0;
+    for (int field : {1, 2, 3, 6, 7, 8})
+        ticks += fields.at(field).toLongLong();
+    return ticksToUs(ticks);
+}
+
+// utime + stime of one process. The command name may contain spaces, so
+// fields are counted from the ')' closing it: state is field 3, utime 14
+qint64 processCpuUs(qint64 pid)
+{
+    QFile file(QStringLiteral("/proc/%1/stat").arg(pid));
+    if (!file.open(QIODevice::ReadOnly))
+        return -1;
+
+    const QByteArray stat = file.readAll();
+    const qsizetype paren = stat.lastIndexOf(')');
+    if (paren < 0)
+        return -1;
+
+    const QList<QByteArray> fields = stat.mid(paren + 2).split(' ');
+    if (fields.size() < 13)
+        return -1;
+    return ticksToUs(fields.at(11).toLongLong() + fields.at(12).toLongLong());
+}
+#endif
+
+} // namespace
+
 // ──────────────────────────────────────────────
 // Constructor / Destructor
 // ──────────────────────────────────────────────
 VideoOptimizer::VideoOptimizer(QObject *parent)
     : QObject(parent)
-    , m_process(new QProcess(this))
 {
-    connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
-            this, &VideoOptimizer::onProcessFinished);
-    connect(m_process, &QProcess::errorOccurred,
-            this, &VideoOptimizer::onProcessError);
-    connect(m_process, &QProcess::readyReadStandardOutput,
-            this, &VideoOptimizer::onProcessOutput);
-    connect(m_process, &QProcess::readyReadStandardError,
-            this, &VideoOptimizer::onProcessOutput);
+    // One candidate walk at a time
+    m_scanPool.setMaxThreadCount(1);
+
+    m_scheduleTimer.setInterval(kScheduleIntervalMs);
+    connect(&m_scheduleTimer, &QTimer::timeout, this, &VideoOptimizer::updateSchedule);
+
+    // Codec of not-yet-indexed candidates
+    connect(MediaProbeService::instance(), &MediaProbeService::probeFinished,
+            this, &VideoOptimizer::onProbeFinished);
 }
 
 VideoOptimizer::~VideoOptimizer()
 {
+    // The walker posts back to this object — let it finish first
+    m_scanPool.clear();
+    m_scanPool.waitForDone();
+
     cancelOptimization();
+    for (Worker *worker : std::as_const(m_workers))
+        delete worker->process;
+    qDeleteAll(m_workers);
+}
+
+// ──────────────────────────────────────────────
+// Worker Pool
+// ──────────────────────────────────────────────
+double VideoOptimizer::availableCpus()
+{
+    return cpusWithin(cgroupCpuLimit());
+}
+
+void VideoOptimizer::ensureWorkers()
+{
+    if (!m_workers.isEmpty())
+        return;
+
+    // Jobs from the configured value or the CPUs, and each job's encoder
+    // threads from its share of them
+    const double cpus = availableCpus();
+    const int jobs = m_concurrency > 0
+                         ? m_concurrency
+                         : qMax(1, int(std::floor(cpus / kThreadsPerJob)));
+    m_threadsPerJob = qMax(1, int(std::floor(cpus / jobs)));
+
+    for (int i = 0; i < jobs; ++i) {
+        auto *worker = new Worker;
+        worker->process = createProcess(worker);
+        m_workers.append(worker);
+    }
+
+    qInfo() << "[VideoOptimizer] Worker pool:" << jobs << "job(s) ×" << m_threadsPerJob
+            << "encoder thread(s) | CPUs available:" << cpus;
+}
+
+QProcess *VideoOptimizer::createProcess(Worker *worker)
+{
+    auto *process = new QProcess(this);
+
+    connect(process, &QProcess::finished, this,
+            [this, worker](int exitCode, QProcess::ExitStatus exitStatus) {
+        onProcessFinished(worker, exitCode, exitStatus);
+    });
+    connect(process, &QProcess::errorOccurred, this,
+            [this, worker](QProcess::ProcessError error) { onProcessError(worker, error); });
+    connect(process, &QProcess::readyReadStandardOutput, this,
+            [this, worker]() { onProcessOutput(worker); });
+    connect(process, &QProcess::readyReadStandardError, this,
+            [this, worker]() { onProcessOutput(worker); });
+
+    // Encode only with what playback leaves over: lowest CPU priority and
+    // the idle I/O class, so the decoder and card reads always come first
+#ifdef Q_OS_UNIX
+    process->setChildProcessModifier([this]() {
+        // Runs in the forked child before exec: async-signal-safe calls only
+        ::setpriority(PRIO_PROCESS, 0, m_niceness);
+#ifdef Q_OS_LINUX
+        ::syscall(SYS_ioprio_set, kIoprioWhoProcess, 0, kIoprioClassIdle << kIoprioClassShift);
+#endif
+    });
+#elif defined(Q_OS_WIN)
+    process->setCreateProcessArgumentsModifier([](QProcess::CreateProcessArguments *args) {
+        args->flags |= IDLE_PRIORITY_CLASS;
+    });
+#endif
+    return process;
+}
+
+int VideoOptimizer::activeJobs() const
+{
+    int active = 0;
+    for (const Worker *worker : m_workers) {
+        if (!worker->job.inputPath.isEmpty())
+            ++active;
+    }
+    return active;
 }
 
 // ──────────────────────────────────────────────
@@ -53,6 +313,358 @@ void VideoOptimizer::setHandbrakePreset(const QString &preset)
     m_handbrakePreset = preset;
 }
 
+void VideoOptimizer::setNiceness(int niceness)
+{
+    m_niceness = qBound(0, niceness, 19);
+}
+
+void VideoOptimizer::setConcurrency(int jobs)
+{
+    // Takes effect when the pool is created (first run)
+    m_concurrency = qMax(0, jobs);
+}
+
+void VideoOptimizer::setAcceptMaxBitrate(int kbps)
+{
+    m_acceptMaxBitrate = qint64(qMax(0, kbps)) * 1000;
+}
+
+void VideoOptimizer::setZoneLayout(const QList<nctv::ZoneDefinition> &zones, const QSize &screen)
+{
+    m_renditionBoxes.clear();
+    for (const nctv::ZoneDefinition &zone : zones) {
+        // Full-screen zones get the preset's own frame size
+        if (zone.width >= screen.width() && zone.height >= screen.height())
+            continue;
+
+        // Rounded up to even: the encoder's chroma subsampling needs it
+        const QSize box((zone.width + 1) & ~1, (zone.height + 1) & ~1);
+        m_renditionBoxes.insert(nctv::zoneIdToFolderName(zone.id), box);
+        qInfo() << "[VideoOptimizer]" << nctv::zoneIdToString(zone.id) << "renditions fit"
+                << box.width() << "x" << box.height();
+    }
+}
+
+void VideoOptimizer::setSchedule(const QStringList &offPeakWindows, int minHeadroomPercent)
+{
+    m_offPeakWindows.clear();
+    for (const QString &entry : offPeakWindows) {
+        const QStringList bounds = entry.trimmed().split(QLatin1Char('-'));
+        const TimeWindow window = {
+            bounds.size() == 2 ? QTime::fromString(bounds.at(0).trimmed(), QStringLiteral("H:mm")) : QTime(),
+            bounds.size() == 2 ? QTime::fromString(bounds.at(1).trimmed(), QStringLiteral("H:mm")) : QTime(),
+        };
+        if (!window.start.isValid() || !window.end.isValid()) {
+            qWarning() << "[VideoOptimizer] Ignoring off-peak window (expected HH:mm-HH:mm):" << entry;
+            continue;
+        }
+        m_offPeakWindows.append(window);
+    }
+    m_minHeadroom = qBound(0, minHeadroomPercent, 100);
+
+    if (!hasSchedule()) {
+        m_scheduleTimer.stop();
+        if (m_paused)
+            setPaused(false, QStringLiteral("no schedule"));
+        return;
+    }
+
+    qInfo() << "[VideoOptimizer] Schedule:" << m_offPeakWindows.size() << "off-peak window(s),"
+            << "headroom needed outside them:" << m_minHeadroom << "%";
+    if (m_isOptimizing)
+        startSchedule();
+}
+
+// ──────────────────────────────────────────────
+// Scheduling
+// ──────────────────────────────────────────────
+bool VideoOptimizer::hasSchedule() const
+{
+    return !m_offPeakWindows.isEmpty() || m_minHeadroom > 0;
+}
+
+// Samples are taken only while a run is active: between runs nothing is
+// read from /proc or the cgroup
+void VideoOptimizer::setOptimizing(bool optimizing)
+{
+    if (m_isOptimizing == optimizing)
+        return;
+    m_isOptimizing = optimizing;
+
+    if (!optimizing) {
+        // No encoder is left to freeze or continue
+        m_scheduleTimer.stop();
+        m_paused = false;
+        m_pauseReason.clear();
+    } else if (hasSchedule()) {
+        startSchedule();
+    }
+    emit isOptimizingChanged();
+}
+
+void VideoOptimizer::startSchedule()
+{
+    // Deltas start over from the first sample
+    m_sampleClock.invalidate();
+    m_lastBusyUs = -1;
+    m_lastNrThrottled = -1;
+    m_lastThrottledUs = -1;
+    m_lastEncoderUs.clear();
+    m_throttleClock.invalidate();
+
+    m_scheduleTimer.start();
+    updateSchedule();
+}
+
+void VideoOptimizer::updateSchedule()
+{
+    const double headroom = sampleHeadroom();
+
+    bool run = true;
+    QString reason;
+    if (m_throttleClock.isValid() && m_throttleClock.elapsed() < kThrottleHoldMs) {
+        // The quota cut the whole service short, playback included: hold the
+        // encoder back whatever the window or the average headroom says
+        run = false;
+        reason = QStringLiteral("CPU quota throttled");
+    } else if (inOffPeakWindow(QTime::currentTime())) {
+        reason = QStringLiteral("off-peak");
+    } else if (m_minHeadroom > 0 && headroom >= 0.0) {
+        const int needed = m_paused ? m_minHeadroom + kResumeHysteresisPercent : m_minHeadroom;
+        run = headroom >= needed;
+        reason = QStringLiteral("playback headroom %1%").arg(qRound(headroom));
+    } else {
+        // Windows only, or headroom not measured (yet / on this platform)
+        run = m_offPeakWindows.isEmpty();
+        reason = QStringLiteral("outside off-peak hours");
+    }
+
+    if (run == m_paused)
+        setPaused(!run, reason);
+}
+
+// Share of the CPUs available to the service (cgroup quota, else the
+// machine) that was not used over the last interval by anything but the
+// encoder, in percent; -1 when it cannot be measured. Also restarts
+// m_throttleClock when the quota throttled the cgroup since the last sample
+double VideoOptimizer::sampleHeadroom()
+{
+#ifdef Q_OS_LINUX
+    // Under a quota, playback and encoder draw on the service's own budget
+    const double limit = cgroupCpuLimit();
+    const CgroupCpuStat cgroup = cgroupCpuStat();
+    const qint64 busyUs = limit > 0.0 ? cgroup.usageUs : systemBusyUs();
+
+    const qint64 lastNrThrottled = std::exchange(m_lastNrThrottled, cgroup.nrThrottled);
+    const qint64 lastThrottledUs = std::exchange(m_lastThrottledUs, cgroup.throttledUs);
+    if (lastNrThrottled >= 0 && cgroup.nrThrottled > lastNrThrottled) {
+        if (!m_throttleClock.isValid() || m_throttleClock.elapsed() >= kThrottleHoldMs) {
+            qInfo() << "[VideoOptimizer] CPU quota throttled" << cgroup.nrThrottled - lastNrThrottled
+                    << "time(s) for" << (cgroup.throttledUs - lastThrottledUs) / 1000 << "ms";
+        }
+        m_throttleClock.start();
+    }
+
+    QHash<qint64, qint64> encoderUs;
+    qint64 encoderDeltaUs = 0;
+    for (const Worker *worker : std::as_const(m_workers)) {
+        const qint64 pid = worker->process->processId();
+        const qint64 us = pid > 0 ? processCpuUs(pid) : -1;
+        if (us < 0)
+            continue;
+        encoderUs.insert(pid, us);
+        encoderDeltaUs += us - m_lastEncoderUs.value(pid, 0);
+    }
+    m_lastEncoderUs = std::move(encoderUs);
+
+    const qint64 elapsedUs = m_sampleClock.isValid() ? m_sampleClock.nsecsElapsed() / 1000 : 0;
+    m_sampleClock.start();
+    const qint64 lastBusyUs = std::exchange(m_lastBusyUs, busyUs);
+    if (busyUs < 0 || lastBusyUs < 0 || elapsedUs <= 0)
+        return -1.0;
+
+    const double capacityUs = cpusWithin(limit) * double(elapsedUs);
+    const double othersUs   = double(busyUs - lastBusyUs - encoderDeltaUs);
+    return qBound(0.0, 100.0 * (1.0 - othersUs / capacityUs), 100.0);
+#else
+    return -1.0;
+#endif
+}
+
+bool VideoOptimizer::inOffPeakWindow(const QTime &time) const
+{
+    for (const TimeWindow &window : m_offPeakWindows) {
+        const bool inside = window.start <= window.end
+                                ? time >= window.start && time < window.end
+                                : time >= window.start || time < window.end;   // Wraps midnight
+        if (inside)
+            return true;
+    }
+    return false;
+}
+
+void VideoOptimizer::setPaused(bool paused, const QString &reason)
+{
+    m_paused = paused;
+    m_pauseReason = paused ? reason : QString();
+
+#ifdef Q_OS_UNIX
+    // Frozen mid-encode: HandBrake continues exactly where it stopped and
+    // uses no CPU meanwhile. Elsewhere only new jobs are held back.
+    for (const Worker *worker : std::as_const(m_workers)) {
+        if (worker->process->state() == QProcess::Running)
+            ::kill(pid_t(worker->process->processId()), paused ? SIGSTOP : SIGCONT);
+    }
+#endif
+
+    qInfo() << "[VideoOptimizer]" << (paused ? "Pausing encoder:" : "Resuming encoder:") << reason;
+
+    if (!m_isOptimizing)
+        return;
+    if (paused)
+        updateStatus();
+    else
+        processNextJob();
+}
+
+// ──────────────────────────────────────────────
+// Job Journal
+// ──────────────────────────────────────────────
+// [ { "input": "...", "output": "...", "state": "pending|running|failed",
+//     "attempts": 1, "inputSize": 123, "inputMtime": 456 }, ... ]
+bool VideoOptimizer::openJournal(const QString &filePath)
+{
+    m_journalPath = filePath;
+    m_journal.clear();
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    if (!doc.isArray()) {
+        qWarning() << "[VideoOptimizer] Ignoring unreadable job journal:" << filePath;
+        return false;
+    }
+
+    int interrupted = 0;
+    for (const QJsonValue &value : doc.array()) {
+        const QJsonObject entry = value.toObject();
+        const QString inputPath = entry.value("input").toString();
+        const QString state     = entry.value("state").toString();
+
+        // The name depends on the source (4K is never boxed); older
+        // journals did not record it
+        QString outputPath = entry.value("output").toString();
+        if (outputPath.isEmpty()) {
+            nctv::MediaInfo info;
+            MediaIndex::instance()->lookup(inputPath, info);
+            outputPath = buildOutputPath(inputPath, info);
+        }
+
+        // Whatever an interrupted encode wrote is incomplete
+        QFile::remove(buildTempPath(outputPath));
+
+        JournalEntry record;
+        record.attempts     = entry.value("attempts").toInt();
+        record.inputSize    = entry.value("inputSize").toInteger();
+        record.inputMtimeMs = entry.value("inputMtime").toInteger();
+        record.outputPath   = outputPath;
+
+        // Gone or replaced since: the next scan judges it afresh
+        const QFileInfo fi(inputPath);
+        if (!fi.exists() || fi.size() != record.inputSize
+            || fi.lastModified().toMSecsSinceEpoch() != record.inputMtimeMs) {
+            continue;
+        }
+
+        if (state == QLatin1String("failed")) {
+            record.state = JobState::Failed;
+        } else {
+            record.state = JobState::Pending;
+            if (state == QLatin1String("running")) {
+                // The rename is confirmed by removing the entry; an output
+                // next to a job still marked running is not trusted
+                if (QFile::remove(outputPath))
+                    qWarning() << "[VideoOptimizer] Removed unconfirmed output:" << outputPath;
+                ++interrupted;
+            }
+        }
+        m_journal.insert(inputPath, record);
+    }
+
+    saveJournal();
+    qInfo() << "[VideoOptimizer] Journal:" << m_journal.size() << "job(s),"
+            << interrupted << "interrupted";
+    return true;
+}
+
+void VideoOptimizer::saveJournal() const
+{
+    if (m_journalPath.isEmpty())
+        return;
+
+    QJsonArray entries;
+    for (auto it = m_journal.constBegin(); it != m_journal.constEnd(); ++it) {
+        const JournalEntry &record = it.value();
+        const char *state = record.state == JobState::Running ? "running"
+                          : record.state == JobState::Failed  ? "failed"
+                                                              : "pending";
+        entries.append(QJsonObject{
+            {"input",      it.key()},
+            {"output",     record.outputPath},
+            {"state",      QLatin1String(state)},
+            {"attempts",   record.attempts},
+            {"inputSize",  record.inputSize},
+            {"inputMtime", record.inputMtimeMs},
+        });
+    }
+
+    QDir().mkpath(QFileInfo(m_journalPath).absolutePath());
+
+    QSaveFile file(m_journalPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[VideoOptimizer] Cannot write job journal:" << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(entries).toJson());
+    if (!file.commit())
+        qWarning() << "[VideoOptimizer] Failed to commit job journal:" << file.errorString();
+}
+
+void VideoOptimizer::setJobState(const QString &inputPath, JobState state)
+{
+    const QFileInfo fi(inputPath);
+    const qint64 size    = fi.size();
+    const qint64 mtimeMs = fi.lastModified().toMSecsSinceEpoch();
+
+    JournalEntry &record = m_journal[inputPath];
+    if (record.inputSize != size || record.inputMtimeMs != mtimeMs) {
+        // New or replaced input: earlier attempts do not count
+        record = JournalEntry();
+        record.inputSize    = size;
+        record.inputMtimeMs = mtimeMs;
+    }
+
+    record.state = state;
+    if (state == JobState::Running)
+        ++record.attempts;
+}
+
+bool VideoOptimizer::isGivenUp(const QString &inputPath) const
+{
+    const QFileInfo fi(inputPath);
+    return isGivenUp(inputPath, fi.size(), fi.lastModified().toMSecsSinceEpoch());
+}
+
+bool VideoOptimizer::isGivenUp(const QString &inputPath, qint64 size, qint64 mtimeMs) const
+{
+    const auto it = m_journal.constFind(inputPath);
+    if (it == m_journal.constEnd() || it->state != JobState::Failed || it->attempts < kMaxAttempts)
+        return false;
+    return size == it->inputSize && mtimeMs == it->inputMtimeMs;
+}
+
 // ──────────────────────────────────────────────
 // Locate HandBrakeCLI
 // ──────────────────────────────────────────────
@@ -94,8 +706,9 @@ bool VideoOptimizer::findHandbrake()
 // ──────────────────────────────────────────────
 void VideoOptimizer::startOptimization()
 {
-    if (m_isOptimizing) {
-        qWarning() << "[VideoOptimizer] Already optimizing, ignoring duplicate start";
+    if (m_isOptimizing || m_scanning) {
+        // New files arrived mid-run: look again once the queue is done
+        m_rescanRequested = true;
         return;
     }
 
@@ -103,7 +716,7 @@ void VideoOptimizer::startOptimization()
     m_statusMessage = "Checking for HandBrakeCLI...";
     emit statusMessageChanged();
 
-    if (!findHandbrake()) {
+    if (m_handbrakePath.isEmpty() && !findHandbrake()) {
         m_statusMessage = "HandBrakeCLI not found — skipping optimization";
         emit statusMessageChanged();
         qInfo() << "[VideoOptimizer] No HandBrakeCLI found, emitting finished immediately";
@@ -114,20 +727,103 @@ void VideoOptimizer::startOptimization()
     m_statusMessage = "Scanning for unoptimized videos...";
     emit statusMessageChanged();
 
+    // Continues in onCandidatesScanned()
     scanForUnoptimizedFiles();
+}
+
+void VideoOptimizer::onCandidatesScanned(const Candidates &candidates)
+{
+    m_scanning = false;
+    if (m_cancelled)
+        return;
+
+    // A probe result may have started a run while the walk was out
+    const qsizetype queuedBefore = m_jobQueue.size();
+
+    // Resume journaled jobs first (interrupted, or still queued at the last exit)
+    int resumed = 0;
+    Candidates ordered;
+    ordered.reserve(candidates.size());
+    for (const Candidate &candidate : candidates) {
+        const auto entry = m_journal.constFind(candidate.inputPath);
+        if (entry != m_journal.constEnd() && entry->state != JobState::Failed) {
+            ordered.insert(resumed++, candidate);
+        } else {
+            ordered.append(candidate);
+        }
+    }
+    if (resumed > 0)
+        qInfo() << "[VideoOptimizer] Resuming" << resumed << "journaled job(s)";
+
+    for (const Candidate &candidate : std::as_const(ordered)) {
+        const QString &inputPath = candidate.inputPath;
+        const QString fileName = QFileInfo(inputPath).fileName();
+
+        if (m_queued.contains(inputPath))
+            continue;
+        if (isGivenUp(inputPath, candidate.size, candidate.mtimeMs)) {
+            qDebug() << "[VideoOptimizer] Failed" << kMaxAttempts << "times, skipping:" << fileName;
+            continue;
+        }
+
+        // Codec from the metadata index; unknown files are probed first
+        // instead of being transcoded blindly
+        if (!candidate.info.valid) {
+            m_awaitingProbe.insert(inputPath);
+            MediaProbeService::instance()->probe(inputPath);
+            continue;
+        }
+        if (candidate.info.acceptedOptimized) {
+            qDebug() << "[VideoOptimizer] Accepted earlier, skipping:" << fileName;
+            continue;
+        }
+
+        // Only finished encodes are ever renamed to the output name
+        if (candidate.outputExists) {
+            qDebug() << "[VideoOptimizer] Already optimized:" << fileName;
+            m_journal.remove(inputPath);
+            continue;
+        }
+        if (meetsTarget(inputPath, candidate.info)) {
+            acceptAsIs(inputPath, candidate.info);
+            continue;
+        }
+
+        enqueueJob(inputPath, candidate.info);
+    }
+
+    saveJournal();
+
+    const int found = int(m_jobQueue.size() - queuedBefore);
+    qInfo() << "[VideoOptimizer] Found" << found << "files needing optimization,"
+            << m_awaitingProbe.size() << "awaiting probe";
+
+    if (m_isOptimizing) {
+        m_totalFiles += found;
+        emit progressChanged();
+        processNextJob();
+        return;
+    }
 
     if (m_jobQueue.isEmpty()) {
-        m_statusMessage = "All videos already optimized";
+        // Candidates still being probed are queued from onProbeFinished()
+        m_statusMessage = m_awaitingProbe.isEmpty()
+                              ? QStringLiteral("All videos already optimized")
+                              : QStringLiteral("Checking %1 video(s)...").arg(m_awaitingProbe.size());
         emit statusMessageChanged();
-        qInfo() << "[VideoOptimizer] No files to optimize";
+        qInfo() << "[VideoOptimizer] No files to optimize yet";
         emit optimizationFinished();
+
+        if (std::exchange(m_rescanRequested, false))
+            QMetaObject::invokeMethod(this, &VideoOptimizer::startOptimization, Qt::QueuedConnection);
         return;
     }
 
+    ensureWorkers();
+
     m_totalFiles = m_jobQueue.size();
     m_completedFiles = 0;
-    m_isOptimizing = true;
-    emit isOptimizingChanged();
+    setOptimizing(true);
     emit progressChanged();
 
     qInfo() << "[VideoOptimizer] Starting optimization of" << m_totalFiles << "files";
@@ -137,16 +833,20 @@ void VideoOptimizer::startOptimization()
 void VideoOptimizer::cancelOptimization()
 {
     m_cancelled = true;
+    m_jobQueue.clear();
+    m_awaitingProbe.clear();
 
-    if (m_process && m_process->state() != QProcess::NotRunning) {
-        qInfo() << "[VideoOptimizer] Cancelling current HandBrake process...";
-        m_process->kill();
-        m_process->waitForFinished(5000);
+    for (Worker *worker : std::as_const(m_workers)) {
+        if (worker->process->state() == QProcess::NotRunning)
+            continue;
+        qInfo() << "[VideoOptimizer] Cancelling HandBrake process for" << worker->job.inputPath;
+        worker->process->kill();
+        worker->process->waitForFinished(5000);
     }
 
-    m_jobQueue.clear();
-    m_isOptimizing = false;
-    emit isOptimizingChanged();
+    // Queued jobs stay pending in the journal and are resumed next run
+    m_queued.clear();
+    setOptimizing(false);
 }
 
 // ──────────────────────────────────────────────
@@ -154,8 +854,25 @@ void VideoOptimizer::cancelOptimization()
 // ──────────────────────────────────────────────
 void VideoOptimizer::scanForUnoptimizedFiles()
 {
-    m_jobQueue.clear();
+    m_scanning = true;
+
+    // The walker gets copies only; it never touches the optimizer's state
+    const QString root   = m_playlistRoot;
+    const QString suffix = m_optimizedSuffix;
+    const QHash<QString, QSize> boxes = m_renditionBoxes;
+
+    m_scanPool.start([this, root, suffix, boxes]() {
+        const Candidates candidates = findCandidates(root, suffix, boxes);
+        QMetaObject::invokeMethod(this, [this, candidates]() {
+            onCandidatesScanned(candidates);
+        }, Qt::QueuedConnection);
+    });
+}
 
+VideoOptimizer::Candidates VideoOptimizer::findCandidates(const QString &playlistRoot,
+                                                          const QString &suffix,
+                                                          const QHash<QString, QSize> &boxes)
+{
     const QStringList zoneDirs = {
         "playlist-background",
         "playlist-main",
@@ -163,8 +880,9 @@ void VideoOptimizer::scanForUnoptimizedFiles()
         "playlist-vertical"
     };
 
+    Candidates candidates;
     for (const QString &zoneDir : zoneDirs) {
-        const QString dirPath = m_playlistRoot + "/" + zoneDir;
+        const QString dirPath = playlistRoot + "/" + zoneDir;
         QDir dir(dirPath);
 
         if (!dir.exists()) {
@@ -176,27 +894,76 @@ void VideoOptimizer::scanForUnoptimizedFiles()
         while (it.hasNext()) {
             it.next();
             const QFileInfo fi = it.fileInfo();
-            const QString ext = fi.suffix().toLower();
-
-            if (!isVideoFile(ext))
+            if (nctv::MediaTypes::fromExtension(fi.suffix()) != nctv::MediaType::Video)
                 continue;
 
-            // Skip files that are already optimized output
-            if (fi.completeBaseName().endsWith(m_optimizedSuffix))
+            // Skip files that are already optimized output (any rendition)
+            QStringView key;
+            QSize box;
+            if (nctv::parseOptimizedStem(fi.completeBaseName(), suffix, &key, &box))
                 continue;
 
-            // Check if optimized version already exists
-            const QString outputPath = buildOutputPath(fi.absoluteFilePath());
-            if (QFileInfo::exists(outputPath)) {
-                qDebug() << "[VideoOptimizer] Already optimized:" << fi.fileName();
-                continue;
+            // Size and mtime come with the directory entry: the index is
+            // checked against them without another stat
+            Candidate candidate;
+            candidate.inputPath = fi.absoluteFilePath();
+            candidate.size      = fi.size();
+            candidate.mtimeMs   = fi.lastModified().toMSecsSinceEpoch();
+            if (MediaIndex::instance()->lookup(candidate.inputPath, candidate.size,
+                                               candidate.mtimeMs, candidate.info)
+                && candidate.info.valid) {
+                const QString outputPath = buildOutputPath(candidate.inputPath, suffix,
+                                                           renditionBox(boxes, candidate.inputPath, candidate.info));
+                candidate.outputExists = QFileInfo::exists(outputPath);
+            } else {
+                candidate.info = nctv::MediaInfo();
             }
-
-            m_jobQueue.enqueue({fi.absoluteFilePath(), outputPath});
+            candidates.append(candidate);
         }
     }
+    return candidates;
+}
 
-    qInfo() << "[VideoOptimizer] Found" << m_jobQueue.size() << "files needing optimization";
+void VideoOptimizer::enqueueJob(const QString &inputPath, const nctv::MediaInfo &info)
+{
+    if (m_queued.contains(inputPath))
+        return;
+
+    const QString outputPath = buildOutputPath(inputPath, info);
+    m_jobQueue.enqueue({inputPath, outputPath, buildTempPath(outputPath), renditionBox(inputPath, info)});
+    m_queued.insert(inputPath);
+    setJobState(inputPath, JobState::Pending);
+    m_journal[inputPath].outputPath = outputPath;
+}
+
+void VideoOptimizer::onProbeFinished(const QString &filePath, const nctv::MediaInfo &info)
+{
+    if (!m_awaitingProbe.remove(filePath) || m_cancelled)
+        return;
+
+    // Unreadable files are left alone; the player deals with them
+    if (!info.valid || info.acceptedOptimized || QFileInfo::exists(buildOutputPath(filePath, info))
+        || m_queued.contains(filePath) || isGivenUp(filePath)) {
+        return;
+    }
+    if (meetsTarget(filePath, info)) {
+        acceptAsIs(filePath, info);
+        return;
+    }
+
+    if (!m_isOptimizing) {
+        // A new run: counters start over
+        ensureWorkers();
+        m_totalFiles     = 0;
+        m_completedFiles = 0;
+        setOptimizing(true);
+    }
+
+    enqueueJob(filePath, info);
+    saveJournal();
+    ++m_totalFiles;
+    emit progressChanged();
+    processNextJob();
 }
 
 // ──────────────────────────────────────────────
@@ -204,84 +971,177 @@ void VideoOptimizer::scanForUnoptimizedFiles()
 // ──────────────────────────────────────────────
 void VideoOptimizer::processNextJob()
 {
+    // Hand queued jobs to idle workers; none start while paused
+    if (!m_cancelled && !m_paused) {
+        for (Worker *worker : std::as_const(m_workers)) {
+            if (m_jobQueue.isEmpty())
+                break;
+            if (worker->job.inputPath.isEmpty())
+                startJob(worker, m_jobQueue.dequeue());
+        }
+    }
+
+    if (activeJobs() > 0 || (m_paused && !m_cancelled && !m_jobQueue.isEmpty())) {
+        updateStatus();
+        return;
+    }
+
     if (m_cancelled || m_jobQueue.isEmpty()) {
-        m_isOptimizing = false;
         m_statusMessage = m_cancelled ? "Optimization cancelled" : "Optimization complete";
-        emit isOptimizingChanged();
+        setOptimizing(false);
         emit statusMessageChanged();
         emit optimizationFinished();
-        return;
+
+        if (std::exchange(m_rescanRequested, false) && !m_cancelled)
+            QMetaObject::invokeMethod(this, &VideoOptimizer::startOptimization, Qt::QueuedConnection);
     }
+}
 
-    const OptimizeJob job = m_jobQueue.dequeue();
-    const QFileInfo fi(job.inputPath);
+void VideoOptimizer::startJob(Worker *worker, const OptimizeJob &job)
+{
+    worker->job      = job;
+    worker->fraction = 0.0;
 
-    m_statusMessage = QStringLiteral("Optimizing (%1/%2): %3")
-                          .arg(m_completedFiles + 1)
-                          .arg(m_totalFiles)
-                          .arg(fi.fileName());
-    emit statusMessageChanged();
+    qInfo() << "[VideoOptimizer] Optimizing:" << QFileInfo(job.inputPath).fileName();
 
-    qInfo() << "[VideoOptimizer]" << m_statusMessage;
+    // Written under a hidden name: scans and watchers ignore it until the
+    // finished file is renamed into place
+    QFile::remove(job.tempPath);
+    setJobState(job.inputPath, JobState::Running);
+    saveJournal();
 
     // Build HandBrakeCLI arguments
     // Target: H.265 (HEVC), quality-based encoding for hardware decode on Pi
     QStringList args;
     args << "-i" << job.inputPath
-         << "-o" << job.outputPath
+         << "-o" << job.tempPath
          << "--preset" << m_handbrakePreset
          << "--encoder" << "x265"
          << "--quality" << "22"          // CRF 22 is a good balance
          << "--encoder-preset" << "medium"
+         << "--encopts" << QStringLiteral("pools=%1").arg(m_threadsPerJob)
          << "--no-markers"
          << "--optimize";
 
+    // Zone renditions: scaled down to fit the zone, aspect ratio kept
+    if (job.box.isValid()) {
+        args << "--maxWidth"  << QString::number(job.box.width())
+             << "--maxHeight" << QString::number(job.box.height());
+    }
+
     qDebug() << "[VideoOptimizer] Running:" << m_handbrakePath << args;
 
-    m_process->start(m_handbrakePath, args);
+    worker->process->start(m_handbrakePath, args);
+}
+
+void VideoOptimizer::updateStatus()
+{
+    const QString state = m_paused
+                              ? QStringLiteral("Paused, %1").arg(m_pauseReason)
+                              : QStringLiteral("Optimizing %1 file(s)").arg(activeJobs());
+    m_statusMessage = QStringLiteral("%1 (%2/%3 done, %4%)")
+                          .arg(state)
+                          .arg(m_completedFiles)
+                          .arg(m_totalFiles)
+                          .arg(qRound(progress() * 100.0));
+    emit statusMessageChanged();
 }
 
 // ──────────────────────────────────────────────
 // Process Event Handlers
 // ──────────────────────────────────────────────
-void VideoOptimizer::onProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
+void VideoOptimizer::onProcessFinished(Worker *worker, int exitCode, QProcess::ExitStatus exitStatus)
 {
-    if (exitStatus == QProcess::CrashExit || exitCode != 0) {
-        qWarning() << "[VideoOptimizer] HandBrake exited with code" << exitCode;
+    const bool success = (exitStatus == QProcess::NormalExit && exitCode == 0);
+    if (!success) {
+        qWarning() << "[VideoOptimizer] HandBrake exited with code" << exitCode
+                   << "for" << worker->job.inputPath;
         emit errorOccurred(QStringLiteral("HandBrake exited with code %1").arg(exitCode));
-    } else {
-        qInfo() << "[VideoOptimizer] File optimization complete";
     }
+    finishJob(worker, success);
+}
 
-    m_completedFiles++;
-    emit progressChanged();
+void VideoOptimizer::onProcessError(Worker *worker, QProcess::ProcessError error)
+{
+    qCritical() << "[VideoOptimizer] QProcess error:" << error
+                << worker->process->errorString();
+    emit errorOccurred("HandBrake process error: " + worker->process->errorString());
 
-    // Continue with next job
-    processNextJob();
+    // Every other error is followed by finished()
+    if (error == QProcess::FailedToStart)
+        finishJob(worker, false);
 }
 
-void VideoOptimizer::onProcessError(QProcess::ProcessError error)
+void VideoOptimizer::finishJob(Worker *worker, bool success)
 {
-    qCritical() << "[VideoOptimizer] QProcess error:" << error
-                << m_process->errorString();
-    emit errorOccurred("HandBrake process error: " + m_process->errorString());
+    const OptimizeJob job = std::exchange(worker->job, OptimizeJob());
+    worker->fraction = 0.0;
+    m_queued.remove(job.inputPath);
+
+    bool done = false;
+    if (success) {
+        // Atomic on the same filesystem: the next scan sees the whole file
+        // or nothing, and zones switch over at their next loop
+        QFile::remove(job.outputPath);
+        done = QFile::rename(job.tempPath, job.outputPath);
+        if (!done)
+            qWarning() << "[VideoOptimizer] Cannot move output into place:" << job.outputPath;
+    }
+    if (!done)
+        QFile::remove(job.tempPath);
+
+    // Journal: finished jobs leave it; a cancelled one (shutdown) stays
+    // pending without the attempt counting against the file
+    if (done) {
+        m_journal.remove(job.inputPath);
+    } else if (m_cancelled) {
+        JournalEntry &record = m_journal[job.inputPath];
+        record.state    = JobState::Pending;
+        record.attempts = qMax(0, record.attempts - 1);
+    } else {
+        setJobState(job.inputPath, JobState::Failed);
+        if (isGivenUp(job.inputPath))
+            qWarning() << "[VideoOptimizer] Giving up after" << kMaxAttempts << "attempts:" << job.inputPath;
+    }
+    saveJournal();
+
+    if (done) {
+        qInfo() << "[VideoOptimizer] File optimization complete:" << job.outputPath;
+        emit fileOptimized(job.inputPath, job.outputPath);
+    }
 
-    // Try next job despite the error
     m_completedFiles++;
     emit progressChanged();
+
+    // Continue with next job
     processNextJob();
 }
 
-void VideoOptimizer::onProcessOutput()
+void VideoOptimizer::onProcessOutput(Worker *worker)
 {
-    // Read and log HandBrake output (useful for progress tracking)
-    const QByteArray stdOut = m_process->readAllStandardOutput();
-    const QByteArray stdErr = m_process->readAllStandardError();
+    const QByteArray stdOut = worker->process->readAllStandardOutput();
+    const QByteArray stdErr = worker->process->readAllStandardError();
 
     if (!stdOut.isEmpty()) {
-        // HandBrake outputs progress info — parse percentage if desired
-        const QString output = QString::fromUtf8(stdOut).trimmed();
-        qDebug() << "[VideoOptimizer][stdout]" << output;
+        // "Encoding: task 1 of 1, 42.17 % (...)" — keep the latest figure
+        static const QRegularExpression percentRe(QStringLiteral("(\\d+(?:\\.\\d+)?) %"));
+        const QString output = QString::fromUtf8(stdOut);
+        QRegularExpressionMatchIterator it = percentRe.globalMatch(output);
+        double percent = -1.0;
+        while (it.hasNext())
+            percent = it.next().captured(1).toDouble();
+
+        if (percent >= 0.0) {
+            const double fraction = qBound(0.0, percent / 100.0, 1.0);
+            // Whole-percent steps are enough for the UI
+            if (qRound(fraction * 100.0) != qRound(worker->fraction * 100.0)) {
+                worker->fraction = fraction;
+                emit progressChanged();
+                updateStatus();
+            }
+        } else {
+            qDebug() << "[VideoOptimizer][stdout]" << output.trimmed();
+        }
     }
     if (!stdErr.isEmpty()) {
         qDebug() << "[VideoOptimizer][stderr]" << QString::fromUtf8(stdErr).trimmed();
@@ -299,29 +1159,101 @@ int VideoOptimizer::completedFiles() const    { return m_completedFiles; }
 double VideoOptimizer::progress() const
 {
     if (m_totalFiles <= 0) return 1.0;
-    return static_cast<double>(m_completedFiles) / static_cast<double>(m_totalFiles);
+
+    // Finished files plus the running encodes' share
+    double done = m_completedFiles;
+    for (const Worker *worker : m_workers)
+        done += worker->fraction;
+    return qMin(1.0, done / static_cast<double>(m_totalFiles));
 }
 
 // ──────────────────────────────────────────────
 // Helpers
 // ──────────────────────────────────────────────
-bool VideoOptimizer::isVideoFile(const QString &ext) const
+QString VideoOptimizer::buildOutputPath(const QString &inputPath, const nctv::MediaInfo &info) const
 {
-    return s_videoExtensions.contains(ext);
+    return buildOutputPath(inputPath, m_optimizedSuffix, renditionBox(m_renditionBoxes, inputPath, info));
 }
 
-QString VideoOptimizer::buildOutputPath(const QString &inputPath) const
+QString VideoOptimizer::buildOutputPath(const QString &inputPath, const QString &suffix, const QSize &box)
 {
     QFileInfo fi(inputPath);
-    // e.g., video.mp4 → video_optimized.mp4
+    // e.g., video.mp4 → video_optimized.mp4, or video_optimized_448x849.mp4
+    // in a zone smaller than the screen
     return fi.absolutePath() + "/"
-         + fi.completeBaseName() + m_optimizedSuffix
+         + fi.completeBaseName() + nctv::renditionSuffix(suffix, box)
          + "." + fi.suffix();
 }
 
-bool VideoOptimizer::isAlreadyHevc(const QString & /*filePath*/) const
+QSize VideoOptimizer::renditionBox(const QString &inputPath, const nctv::MediaInfo &info) const
 {
-    // TODO: Use ffprobe or mediainfo to check codec
-    // For now, rely on the filename-based optimized suffix check
-    return false;
+    return renditionBox(m_renditionBoxes, inputPath, info);
+}
+
+QSize VideoOptimizer::renditionBox(const QHash<QString, QSize> &boxes, const QString &inputPath,
+                                   const nctv::MediaInfo &info)
+{
+    // 4K content plays as a fullscreen overlay, not in its zone: sized by
+    // the preset like a full-screen zone, so the overlay path keeps it
+    if (info.is4K())
+        return QSize();
+
+    // The zone is the one whose folder holds the file
+    return boxes.value(QFileInfo(inputPath).dir().dirName());
+}
+
+QString VideoOptimizer::buildTempPath(const QString &outputPath)
+{
+    QFileInfo fi(outputPath);
+    // e.g., video_optimized.mp4 → .video_optimized.partial.mp4 (extension
+    // kept last so HandBrake still picks the container from it)
+    return fi.absolutePath() + "/."
+         + fi.completeBaseName() + ".partial"
+         + "." + fi.suffix();
+}
+
+// ──────────────────────────────────────────────
+// Target Check
+// ──────────────────────────────────────────────
+bool VideoOptimizer::meetsTarget(const QString &filePath, const nctv::MediaInfo &info) const
+{
+    // Stream parameters as recorded by MediaProbeService; unknown profile
+    // and bitrate (not every container reports them) do not disqualify
+    const QString codec = info.codec.toLower();
+    const bool hevc = codec == QLatin1String("hevc") || codec == QLatin1String("h265")
+                   || codec == QLatin1String("hvc1") || codec == QLatin1String("hev1");
+    if (!info.valid || !hevc)
+        return false;
+
+    if (info.profile > 0 && info.profile != kHevcProfileMain && info.profile != kHevcProfileMain10)
+        return false;
+    if (info.width > kTargetMaxWidth || info.height > kTargetMaxHeight || info.frameRate > kTargetMaxFps)
+        return false;
+    if (m_acceptMaxBitrate > 0 && info.bitrate > m_acceptMaxBitrate)
+        return false;
+
+    // Larger than its zone: decoding pixels nobody sees (4K content has
+    // no box, it plays as a fullscreen overlay rather than in the zone)
+    const QSize box = renditionBox(filePath, info);
+    if (box.isValid() && (int(info.width) > box.width() || int(info.height) > box.height())) {
+        return false;
+    }
+    return true;
+}
+
+void VideoOptimizer::acceptAsIs(const QString &filePath, nctv::MediaInfo info)
+{
+    const QFileInfo fi(filePath);
+    if (!fi.exists())
+        return;
+
+    // Remembered with the file's size and mtime: a replaced file is judged again
+    info.acceptedOptimized = true;
+    MediaIndex::instance()->insert(filePath, fi.size(), fi.lastModified().toMSecsSinceEpoch(), info);
+    MediaCache::instance()->insertMediaInfo(filePath, info);
+
+    qInfo() << "[VideoOptimizer] Already meets target, kept as-is:" << fi.fileName()
+            << info.width << "x" << info.height << info.codec << "profile" << info.profile
+            << info.bitrate / 1000 << "kb/s";
+    emit fileAccepted(filePath, info);
 }
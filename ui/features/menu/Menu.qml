@@ -71,6 +71,18 @@ Rectangle {
                 Text { color: "#aaa"; text: "Retry Interval:" }
                 Text { color: "white"; text: appConfig.retryIntervalMs + " ms" }
 
+                Text { color: "#aaa"; text: "Quarantined:" }
+                Text { color: mediaQuarantine.quarantined.length > 0 ? "#f0a030" : "white"
+                       text: mediaQuarantine.quarantined.length + " file(s)" }
+
+                Text { color: "#aaa"; text: "Decode Load:" }
+                Text { color: decodeBudget.load > decodeBudget.capacity * 0.9 ? "#f0a030" : "white"
+                       text: decodeBudget.load.toFixed(1) + " / " + decodeBudget.capacity.toFixed(1) }
+
+                Text { color: "#aaa"; text: "Optimizer:" }
+                Text { color: "white"; text: videoOptimizer.statusMessage; elide: Text.ElideRight;
+                       Layout.maximumWidth: 300 }
+
                 Text { color: "#aaa"; text: "Resolution:" }
                 Text { color: "white"; text: appConfig.targetWidth + "×" + appConfig.targetHeight }
 
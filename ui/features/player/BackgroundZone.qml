@@ -1,4 +1,5 @@
 import QtQuick
+import Nctv.Video 1.0
 
 /**
  * BackgroundZone.qml - Full-screen background content zone.
@@ -14,6 +15,12 @@ Item {
         color: "transparent"
     }
 
+    // Scene graph video layer (renderMode=scenegraph); empty in native mode
+    VideoSurface {
+        anchors.fill: parent
+        player: backgroundPlayer
+    }
+
     // Image fallback layer — visible when showing a static image
     Image {
         id: bgImage
@@ -1,4 +1,5 @@
 import QtQuick
+import Nctv.Video 1.0
 
 /**
  * HorizontalZone.qml - Bottom banner / ticker zone.
@@ -13,6 +14,12 @@ Item {
         color: "transparent"
     }
 
+    // Scene graph video layer (renderMode=scenegraph); empty in native mode
+    VideoSurface {
+        anchors.fill: parent
+        player: horizontalPlayer
+    }
+
     Image {
         id: hImage
         anchors.fill: parent
@@ -1,5 +1,6 @@
 import QtQuick
 import QtQuick.Window
+import Nctv.Video 1.0
 
 /**
  * MainZone.qml - Primary content zone (top-left area).
@@ -14,6 +15,12 @@ Item {
         color: "transparent" // Crucial: must be transparent for VLC overlay
     }
 
+    // Scene graph video layer (renderMode=scenegraph); empty in native mode
+    VideoSurface {
+        anchors.fill: parent
+        player: mainPlayer
+    }
+
     Image {
         id: mainImage
         anchors.fill: parent
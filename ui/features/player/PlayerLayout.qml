@@ -76,6 +76,14 @@ Item {
         z: 1
     }
 
+    // ── Occlusion ──
+    // A 4K main video plays as a fullscreen overlay and the other zones are
+    // hidden; their players suspend (occlusionPolicy) so they do not compete
+    // with the 4K decode, and resume where they were when it ends.
+    Binding { target: backgroundPlayer; property: "occluded"; value: mainPlayer.is4K }
+    Binding { target: horizontalPlayer; property: "occluded"; value: mainPlayer.is4K }
+    Binding { target: verticalPlayer;   property: "occluded"; value: mainPlayer.is4K }
+
     // ── Debug Overlay (toggle with F11) ──
     Rectangle {
         id: debugOverlay
@@ -83,7 +91,7 @@ Item {
         anchors.top: parent.top
         anchors.right: parent.right
         anchors.margins: 10
-        width: 300; height: 200
+        width: 300; height: 220
         color: "#CC000000"
         radius: 8
         z: 50
@@ -109,6 +117,10 @@ Item {
                       "  " + (verticalPlayer.isPlaying ? "▶" : "⏸") }
             Text { color: "#aaa"; font.pixelSize: 10
                 text: "ImgDur: " + appConfig.imageDurationMs + "ms" }
+            Text { color: "#aaa"; font.pixelSize: 10
+                text: "Cache: " + mediaCache.stats.hits + " hit / " + mediaCache.stats.misses + " miss  " +
+                      Math.round(mediaCache.stats.usedBytes / 1048576) + "/" +
+                      Math.round(mediaCache.stats.budgetBytes / 1048576) + " MB" }
         }
     }
 
@@ -118,21 +130,31 @@ Item {
     }
 
     // ── Playlist → ZonePlayer Binding ──
-    // When PlaylistService emits playlistsChanged, feed files into each ZonePlayer
+    // PlaylistService emits zonePlaylistChanged for each zone whose folder
+    // content changed; only that zone's player is updated. setPlaylist()
+    // takes the zone's ZonePlaylistModel and diffs it against the current
+    // list, so the playing item is kept.
+    function playerForZone(zoneName) {
+        switch (zoneName) {
+        case "background": return backgroundPlayer;
+        case "main":       return mainPlayer;
+        case "horizontal": return horizontalPlayer;
+        case "vertical":   return verticalPlayer;
+        }
+        return null;
+    }
+
     Connections {
         target: playlistService
-        function onPlaylistsChanged() {
-            console.log("[PlayerLayout] Playlists updated, loading into zone players...");
-            backgroundPlayer.setPlaylist(playlistService.backgroundFiles);
-            mainPlayer.setPlaylist(playlistService.mainFiles);
-            horizontalPlayer.setPlaylist(playlistService.horizontalFiles);
-            verticalPlayer.setPlaylist(playlistService.verticalFiles);
-
-            // Start playback on all zones
-            backgroundPlayer.play();
-            mainPlayer.play();
-            horizontalPlayer.play();
-            verticalPlayer.play();
+        function onZonePlaylistChanged(zoneName) {
+            var player = playerForZone(zoneName);
+            if (!player) return;
+
+            console.log("[PlayerLayout] Playlist updated for zone: " + zoneName);
+            player.setPlaylist(playlistService.modelForZone(zoneName));
+
+            // Start zones that are idle; playing zones apply the update in place
+            if (!player.isPlaying) player.play();
         }
     }
 
@@ -144,10 +166,10 @@ Item {
             playlistService.mainFiles.length > 0 ||
             playlistService.horizontalFiles.length > 0 ||
             playlistService.verticalFiles.length > 0) {
-            backgroundPlayer.setPlaylist(playlistService.backgroundFiles);
-            mainPlayer.setPlaylist(playlistService.mainFiles);
-            horizontalPlayer.setPlaylist(playlistService.horizontalFiles);
-            verticalPlayer.setPlaylist(playlistService.verticalFiles);
+            backgroundPlayer.setPlaylist(playlistService.modelForZone("background"));
+            mainPlayer.setPlaylist(playlistService.modelForZone("main"));
+            horizontalPlayer.setPlaylist(playlistService.modelForZone("horizontal"));
+            verticalPlayer.setPlaylist(playlistService.modelForZone("vertical"));
 
             backgroundPlayer.play();
             mainPlayer.play();
@@ -1,4 +1,5 @@
 import QtQuick
+import Nctv.Video 1.0
 
 /**
  * VerticalZone.qml - Right sidebar content zone.
@@ -13,6 +14,12 @@ Item {
         color: "transparent"
     }
 
+    // Scene graph video layer (renderMode=scenegraph); empty in native mode
+    VideoSurface {
+        anchors.fill: parent
+        player: verticalPlayer
+    }
+
     Image {
         id: vImage
         anchors.fill: parent